@@ -4,9 +4,22 @@ set(CORE_SOURCES
 
 set(SCHEME_SOURCES
         src/scheme/scheme.cpp
+        src/scheme/arena.cpp
+        src/scheme/layout.cpp
         src/scheme/assign.cpp
         src/scheme/set-links.cpp
         src/scheme/signals.cpp
+        src/scheme/tape.cpp
+        src/scheme/parallel.cpp
+        src/scheme/partition.cpp
+        src/scheme/events.cpp
+        src/scheme/rates.cpp
+        src/scheme/steady.cpp
+        src/scheme/state.cpp
+        src/scheme/fork.cpp
+        src/scheme/freeze-port.cpp
+        src/scheme/image.cpp
+        src/scheme/cache.cpp
 
         src/scheme/create-blocks/delays.cpp
         src/scheme/create-blocks/dynamic.cpp
@@ -22,10 +35,30 @@ set(SCHEME_SOURCES
 
 set(BLOCK_SOURCES
         src/block/block.cpp
+        src/block/discretization.cpp
+)
+
+set(TAPE_SOURCES
+        src/tape/tape.cpp
+        src/tape/batch.cpp
+        src/tape/sensitivity.cpp
+        src/tape/image.cpp
+)
+
+set(PARALLEL_SOURCES
+        src/parallel/worker-pool.cpp
+        src/parallel/task-graph.cpp
+)
+
+set(ENSEMBLE_SOURCES
+        src/ensemble/ensemble.cpp
 )
 
 set(SOURCES
         ${CORE_SOURCES}
         ${SCHEME_SOURCES}
         ${BLOCK_SOURCES}
+        ${TAPE_SOURCES}
+        ${PARALLEL_SOURCES}
+        ${ENSEMBLE_SOURCES}
 )
\ No newline at end of file
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "constants/config.hxx"
+#include "tape.hpp"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace nrcki {
+/**
+ * Пакетный расчёт: N независимых экземпляров одной схемы по общей ленте инструкций.
+ * Каждый слот порта, параметр, переменная состояния и внешний вход хранятся полосой
+ * из N значений ([index * lanes + lane]), поэтому каждая инструкция обрабатывает все экземпляры за один проход.
+ * Параметры экземпляра индексируются как в Sensitivity: параметры блока (Block::getParameters(): k, T, b, y0
+ * динамических звеньев, x1, x2, y1, y2 ограничения, узлы [x[n], y[n]] характеристики), либо встроенные
+ * параметры инструкции блока (раскладка - см. Tape::run), если блок своих параметров не задаёт.
+ * Изменённый параметр блока пересчитывается блоком в коэффициенты инструкции своей полосы (Block::lowerValues()),
+ * производные коэффициенты (дискретизация, наклоны участков) напрямую не задаются.
+ * Пока пакет, созданный из нерассчитанной схемы, ещё не рассчитывался, параметр блока задаёт и начальное
+ * состояние: начальные условия (y0, dy0) - выход и состояние полосы, выходы остальных блоков рассчитываются
+ * заново, как Block::init() (выходы блоков без состояния и состояние, снимаемое с входа, - только в этой полосе).
+ * Иначе начальное состояние задаётся через setOutput() и setState().
+ * Все блоки схемы должны понижаться в ленту: схема с блоками, рассчитываемыми через compute()
+ * (логические порты bool, точность Single, блоки без понижения), в пакетном режиме не поддерживается.
+ */
+class Batch {
+    using Type = types::real;
+    using size = types::size;
+
+    Tape tape;
+    size lanes;
+
+    std::vector<Type> memory; // Слоты портов: slot -> lane
+    std::vector<Type> state;  // Состояние: index -> lane
+    std::vector<Type> params; // Параметры: index -> lane
+    std::vector<Type> inputs; // Внешние входы: signal -> lane
+    std::vector<Type> values; // Параметры блоков: index -> lane
+
+    std::vector<size> instructions;         // Блок -> индекс инструкции (-1, если блок не в ленте)
+    std::vector<std::pair<size, size>> own; // Блок -> [начало, конец) параметров блока в values
+    bool initial;                           // Пакет создан из нерассчитанной схемы
+
+    size dt_count    = 0; // Число шагов интегрирования
+    types::time time = 0; // Абсолютное время
+    types::time dt   = 0; // Шаг интегрирования схемы
+
+    /// Блок задаёт свои параметры (Block::getParameters())
+    bool has_own(size block) const;
+    /// Смещение параметра блока в values, либо в params для блока без своих параметров (без учёта полос)
+    size param_offset(size block, size index) const;
+    size state_offset(size block, size index) const;
+
+    /// Пересчёт параметров инструкции блока полосы lane по параметрам блока
+    void lower_lane(size block, size lane);
+
+public:
+    Batch(const Tape& compiled, const Type* ports_memory, const std::vector<Type>& signals,
+          std::vector<size> block_instructions, types::time start, types::time step, bool initial_state,
+          size lanes_count);
+
+    void compute(uint64_t steps = 1);
+
+    [[nodiscard]] size getLanes() const { return lanes; }
+    [[nodiscard]] size getSteps() const { return dt_count; }
+    [[nodiscard]] types::time getTime() const { return time; }
+
+    /// Относительная индексация вещественных выходных портов
+    [[nodiscard]] Type getOutput(const size index, const size lane) const { return memory[index * lanes + lane]; }
+    [[nodiscard]] const Type* getOutputLanes(const size index) const { return memory.data() + index * lanes; }
+    void setOutput(const size index, const size lane, const Type value) { memory[index * lanes + lane] = value; }
+
+    void setInput(const size index, const size lane, const Type value) { inputs[index * lanes + lane] = value; }
+
+    /// Параметры блока (см. выше) и состояние инструкции блока (раскладка - см. Tape::run)
+    [[nodiscard]] Type getParameter(size block, size index, size lane) const;
+    void setParameter(size block, size index, size lane, Type value);
+    [[nodiscard]] Type getState(size block, size index, size lane) const;
+    void setState(size block, size index, size lane, Type value);
+};
+}
\ No newline at end of file
@@ -2,14 +2,24 @@
 
 #include "constants/config.hxx"
 #include "context.hpp"
+#include "dual.hpp"
 #include "signals.h"
 
+#include <atomic>
+#include <functional>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <type_traits>
 #include <vector>
 #include <unordered_map>
 
 
 namespace nrcki {
 class PortsBase;
+template <typename T>
+class Ports;
+class Tape;
 
 class Block {
     using size = types::size;
@@ -19,38 +29,121 @@ class Block {
     // Абсолютная индексация:
     std::vector<std::pair<size, size>> absolute_input_ports;
     std::vector<void*> absolute_output_ports;
+    std::vector<size> absolute_output_types;
 
-    inline static size count = -1;
+    inline static std::atomic<size> count{static_cast<size>(-1)}; // Блоки могут создаваться в нескольких потоках
 
     int flags = 0;
 
+    // Частота расчёта: блок рассчитывается на шагах step, для которых step % period == offset
+    size period = 1, offset = 0;
+
 protected:
-    const Context& context;
+    const Context* context;
     const size id;
 
     enum FlagType {
         CONSTANT = 1 << 0,
         CAN_UNTIE_LOOP = 1 << 1,
         IMPLICIT_COMPUTE = 1 << 2,
+        EVENT_DRIVEN = 1 << 3, // Выход зависит только от входов (и собственного выхода): расчёт при изменении входов
+        TIMER = 1 << 4,        // Выход зависит от времени только через сроки deadline(): расчёт при изменении входов и по сроку
     };
 
     SignalsBase* signals = nullptr;
 
     void register_ports(PortsBase* base);
+
+    // Порты с n входами типа In и m выходами типа Out (одни порты, если типы совпадают)
+    template <typename In, typename Out>
+    void register_ports(const size n, const size m, Ports<In>*& in, Ports<Out>*& out) {
+        if constexpr (std::is_same_v<In, Out>) {
+            in = out = new Ports<In>(n, m);
+            register_ports(in);
+        }
+        else {
+            in  = new Ports<In>(n, 0);
+            out = new Ports<Out>(0, m);
+            register_ports(in);
+            register_ports(out);
+        }
+    }
     void register_signals(SignalsBase* s) { signals = s; }
 
+    // Шаг расчёта блока (период дискретизации, кратный шагу интегрирования схемы):
+    types::time step() const { return context->dt * static_cast<types::time>(period); }
+    types::real step_sec() const { return context->dt_sec * static_cast<types::real>(period); }
+
+    // Ближайший из ещё не наступивших моментов времени (max, если все наступили)
+    types::time upcoming(std::initializer_list<types::time> moments) const {
+        auto result = std::numeric_limits<types::time>::max();
+        for (const auto moment : moments)
+            if (moment > context->time && moment < result)
+                result = moment;
+        return result;
+    }
+
+    // Обход внутреннего состояния: visit получает адрес и размер участка памяти
+    using StateVisitor = std::function<void(void*, size)>;
+
+    template <typename T>
+    static void visit_value(const StateVisitor& visit, T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "block state must be trivially copyable");
+        visit(&value, sizeof value);
+    }
+
+    template <typename T>
+    static void visit_value(const StateVisitor& visit, std::vector<T>& values) {
+        visit(values.data(), values.size() * sizeof(T));
+    }
+
+    template <typename... T>
+    static void visit_state(const StateVisitor& visit, T&... values) {
+        (visit_value(visit, values), ...);
+    }
+
+    // Копирование портов и сигналов (адреса памяти остаются прежними до перевода схемой)
+    Block(const Block& other);
+
+    // Копия блока типа Derived для другого контекста; ports - типизированные указатели на порты блока
+    template <typename Derived, typename... P>
+    std::unique_ptr<Block> clone_as(const Context& value, P* Derived::*... ports) const {
+        auto copy    = std::make_unique<Derived>(static_cast<const Derived&>(*this));
+        Block& base  = *copy;
+        base.context = &value;
+        (((*copy).*ports = static_cast<P*>(base.ports_bases.at(((*copy).*ports)->getTypeHash()))), ...);
+        return copy;
+    }
+
 public:
-    explicit Block(const Context& context) : context(context), id(++count) {
+    explicit Block(const Context& context) : context(&context), id(++count) {
     }
 
     virtual ~Block();
 
+    // Копия блока для копии схемы: параметры и состояние копируются, порты и сигналы - собственные
+    virtual std::unique_ptr<Block> clone(const Context& context) const = 0;
+
     std::unordered_map<size, size> inputs() const;
     std::unordered_map<size, size> outputs() const;
     void outputs(std::unordered_map<size, void*> memory);
     SignalsBase* getSignals() const { return signals; }
 
+    // Контекст расчёта (время, индексы портов) - может быть заменён, например, контекстом компоненты схемы:
+    const Context& getContext() const { return *context; }
+    void setContext(const Context& value) { context = &value; }
+
     void initIndices();
+    uint32_t* bindInputs(uint32_t* table, const std::unordered_map<size, void*>& bases);
+    std::vector<uint32_t> getInputSlots() const;
+    size getInputType(const size index) const { return absolute_input_ports[index].first; }
+    size getOutputType(const size index) const { return absolute_output_types[index]; }
+
+    // Период дискретизации (в шагах интегрирования схемы) и смещение первого расчёта:
+    size getPeriod() const { return period; }
+    size getOffset() const { return offset; }
+    void setPeriod(const size value, const size first = 0) { period = value, offset = first, discretize(); }
+    bool isDue(const uint64_t step) const { return period == 1 || step % period == offset; }
 
     // Виртуальный расчёт:
     virtual void init() const { this->compute(); }
@@ -58,6 +151,26 @@ public:
     virtual void compute() const {
     }
 
+    // Пересчёт дискретных коэффициентов блока при изменении шага расчёта (шаг схемы, период дискретизации):
+    virtual void discretize() {
+    }
+
+    // Понижение в ленту инструкций (false - блок рассчитывается через compute()):
+    virtual bool lower(Tape&) const { return false; }
+
+    // Параметры блока для анализа чувствительности и пакетного расчёта
+    // (пусто - параметры инструкции ленты блока, см. Sensitivity, Batch):
+    virtual std::vector<types::real> getParameters() const { return {}; }
+
+    // Параметры инструкции ленты params как функции параметров блока values в дуальных числах;
+    // output и state (выход и состояние блока на ленте) - из начального состояния схемы, иначе nullptr:
+    virtual void lowerTangent(const Tangent*, Tangent*, Tangent*, Tangent*) const {
+    }
+
+    // То же в вещественных числах: параметры инструкции одного экземпляра пакетного расчёта (см. Batch):
+    virtual void lowerValues(const types::real*, types::real*, types::real*, types::real*) const {
+    }
+
     // Поддержка флагов:
     void toggleFlag(const int flag) { flags ^= flag; };
 
@@ -65,9 +178,27 @@ public:
     bool isConstant() const { return flags & CONSTANT; }
     bool canUntieLoop() const { return flags & CAN_UNTIE_LOOP; }
     bool isImplicitCompute() const { return flags & IMPLICIT_COMPUTE; }
+    bool isEventDriven() const { return flags & EVENT_DRIVEN; }
+    bool isTimer() const { return flags & TIMER; }
 
     virtual bool tryMakeConstant() { return false; }
 
+    // Срок таймера (для блоков TIMER): ближайший момент, когда выход может измениться без изменения входов
+    virtual types::time deadline() const { return std::numeric_limits<types::time>::max(); }
+
+    // Установившийся режим: при неизменных входах выходы и состояние меняются за шаг не более чем на tolerance
+    // (по результату следующего шага в арифметике блока: при tolerance = 0 - точно неизменны)
+    virtual bool isSteady(types::real) const { return isConstant() || isEventDriven() || isTimer(); }
+
+    // Неявные входы (порты других блоков, читаемые не через связи):
+    // visit получает указатель и возвращает его новое значение (при перемещении памяти портов)
+    virtual void visitImplicitInputs(const std::function<void*(void*)>&) const {
+    }
+
+    // Внутреннее состояние (память между шагами помимо выходов): снимок и восстановление схемы
+    virtual void visitState(const StateVisitor&) const {
+    }
+
     // Кодогенерация:
     [[maybe_unused]] virtual types::string printMemory() const { return ""; }
     [[maybe_unused]] virtual types::string printInit() const { return this->printSource(); }
@@ -75,10 +206,10 @@ public:
 
 #define CODE_NAME_IN(PORTS, INDEX) \
 types::type_codename(PORTS->getTypeHash()) + \
-'[' + std::to_string(context.ports_info.at(PORTS->inputs[INDEX]).relative_index) + ']'
+'[' + std::to_string(context->ports_info.at(PORTS->inputs[INDEX]).relative_index) + ']'
 #define CODE_NAME_OUT(PORTS, INDEX) \
 types::type_codename(PORTS->getTypeHash()) + \
-'[' + std::to_string(context.ports_info.at(&PORTS->outputs[INDEX]).relative_index) + ']'
+'[' + std::to_string(context->ports_info.at(&PORTS->outputs[INDEX]).relative_index) + ']'
 #define CODE_NAME_SIGNAL_IN(SIGNALS, INDEX) (\
 "input_signals[" + std::to_string((SIGNALS)->getInputOffset() + static_cast<size_t>(INDEX)) + ']')
 #define CODE_NAME_SIGNAL_OUT(SIGNALS, INDEX) (\
@@ -104,5 +235,9 @@ const auto var_ ## NAME = #NAME"_" + std::to_string(Block::id);
     [[maybe_unused]] virtual void* getOutputPortRelative(size type_hash, size index) const;
 
     [[maybe_unused]] const std::vector<void*>& getOutputPortsAbsolute() const;
+
+    // Абсолютный индекс относительного порта index типа type_hash (исключение, если такого порта нет):
+    size getInputIndex(size type_hash, size index) const;
+    size getOutputIndex(size type_hash, size index) const;
 };
 }
\ No newline at end of file
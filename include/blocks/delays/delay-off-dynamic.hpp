@@ -29,13 +29,18 @@ public:
         timer_active(false) {
         ports = new Ports<Type>(2, 1);
         register_ports(ports);
+        toggleFlag(TIMER);
+    }
+
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &DelayOffDynamic::ports);
     }
 
     void compute() const override {
         Type current_x = *ports->inputs[0];
         Type current_T = *ports->inputs[1];
 
-        bool x_changed = (current_x != 0) != (timer_active && context.time < T_off);
+        bool x_changed = (current_x != 0) != (timer_active && context->time < T_off);
         bool T_changed = prev_T != current_T;
 
         if (x_changed) {
@@ -47,20 +52,20 @@ public:
             else {
                 // Входной сигнал стал нулевым - запускаем таймер
                 timer_active = true;
-                time_start   = context.time;
+                time_start   = context->time;
                 T_off        = time_start + static_cast<Time>(current_T * Context::sec);
             }
         }
         else if (T_changed && timer_active) {
             // T изменился во время работы таймера - пересчитываем оставшееся время
-            Time elapsed = context.time - time_start; // Прошедшее время
+            Time elapsed = context->time - time_start; // Прошедшее время
             Type old_T   = prev_T;
 
             if (current_T > old_T) {
                 // Увеличили T - продлеваем таймер
                 Time remaining_old   = static_cast<Time>(old_T * Context::sec) - elapsed;
                 Time additional_time = static_cast<Time>((current_T - old_T) * Context::sec);
-                T_off                = context.time + remaining_old + additional_time;
+                T_off                = context->time + remaining_old + additional_time;
             }
             else {
                 // Уменьшили T - возможно, таймер уже истек
@@ -71,7 +76,7 @@ public:
                 }
                 else {
                     // Таймер уже истек
-                    T_off = context.time; // Устанавливаем прошедшее время
+                    T_off = context->time; // Устанавливаем прошедшее время
                 }
             }
         }
@@ -79,7 +84,11 @@ public:
         prev_T = current_T;
 
         // Выход = true, если таймер активен и время не истекло
-        ports->outputs[0] = timer_active && context.time < T_off;
+        ports->outputs[0] = timer_active && context->time < T_off;
+    }
+
+    types::time deadline() const override {
+        return upcoming({T_off});
     }
 
     std::string printMemory() const override {
@@ -98,6 +107,10 @@ public:
         return line.str();
     }
 
+    void visitState(const StateVisitor& visit) const override {
+        visit_state(visit, T_off, time_start, prev_T, timer_active);
+    }
+
     types::string printSource() const override {
         const auto type    = CODE_NAME_TYPE(Time);
         const auto x       = CODE_NAME_IN(ports, 0);
@@ -9,11 +9,12 @@
 #include <cmath>
 
 namespace nrcki {
+template <typename Logic = types::real>
 class DelayOff final : public Block {
     using Type = types::real;
     using Time = types::time;
 
-    Ports<Type>* ports;
+    Ports<Logic>* ports;
 
     const Time T;
     mutable Time T_off;
@@ -24,15 +25,24 @@ public:
         Block(context),
         T(static_cast<Time>(T * Context::sec)),
         T_off(std::numeric_limits<Time>::min()) {
-        ports = new Ports<Type>(1, 1);
+        ports = new Ports<Logic>(1, 1);
         register_ports(ports);
+        toggleFlag(TIMER);
+    }
+
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &DelayOff::ports);
     }
 
     void compute() const override {
         if (prev_x != (*ports->inputs[0] != 0))
-            T_off = prev_x ? context.time + T : std::numeric_limits<Time>::max();
+            T_off = prev_x ? context->time + T : std::numeric_limits<Time>::max();
         prev_x            = *ports->inputs[0] != 0;
-        ports->outputs[0] = context.time < T_off;
+        ports->outputs[0] = context->time < T_off;
+    }
+
+    types::time deadline() const override {
+        return upcoming({T_off});
     }
 
     std::string printMemory() const override {
@@ -47,6 +57,10 @@ public:
         return line.str();
     }
 
+    void visitState(const StateVisitor& visit) const override {
+        visit_state(visit, T_off, prev_x);
+    }
+
     types::string printSource() const override {
         const auto x   = CODE_NAME_IN(ports, 0);
         const auto y   = CODE_NAME_OUT(ports, 0);
@@ -30,6 +30,11 @@ public:
         // Порты: входной сигнал, параметр T, выход
         ports = new Ports<Type>(2, 1);
         register_ports(ports);
+        toggleFlag(TIMER);
+    }
+
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &DelayOnDynamic::ports);
     }
 
     void compute() const override {
@@ -42,7 +47,7 @@ public:
             if (current_x != 0) {
                 // Входной сигнал стал ненулевым - запускаем таймер
                 timer_active = true;
-                time_start   = context.time;
+                time_start   = context->time;
                 T_on         = time_start + static_cast<Time>(current_T * Context::sec);
             }
             else {
@@ -53,14 +58,14 @@ public:
         }
         else if (timer_active && prev_T != current_T) {
             // T изменился во время работы таймера - пересчитываем оставшееся время
-            Time elapsed = context.time - time_start; // Прошедшее время
+            Time elapsed = context->time - time_start; // Прошедшее время
             Type old_T   = prev_T;
 
             if (current_T > old_T) {
                 // Увеличили T - продлеваем таймер
                 Time remaining_old   = static_cast<Time>(old_T * Context::sec) - elapsed;
                 Time additional_time = static_cast<Time>((current_T - old_T) * Context::sec);
-                T_on                 = context.time + remaining_old + additional_time;
+                T_on                 = context->time + remaining_old + additional_time;
             }
             else {
                 // Уменьшили T - возможно, таймер уже истек
@@ -71,7 +76,7 @@ public:
                 }
                 else {
                     // Таймер уже истек
-                    T_on = context.time; // Устанавливаем текущее время
+                    T_on = context->time; // Устанавливаем текущее время
                 }
             }
         }
@@ -79,7 +84,11 @@ public:
         prev_T = current_T;
 
         // Выход = true, если таймер активен и текущее время больше или равно времени включения
-        ports->outputs[0] = timer_active && context.time >= T_on;
+        ports->outputs[0] = timer_active && context->time >= T_on;
+    }
+
+    types::time deadline() const override {
+        return upcoming({T_on});
     }
 
     std::string printMemory() const override {
@@ -98,6 +107,10 @@ public:
         return line.str();
     }
 
+    void visitState(const StateVisitor& visit) const override {
+        visit_state(visit, T_on, time_start, prev_T, timer_active);
+    }
+
     types::string printSource() const override {
         const auto type    = CODE_NAME_TYPE(Time);
         const auto x       = CODE_NAME_IN(ports, 0);
@@ -30,6 +30,11 @@ public:
         // Порты: входной сигнал, T_on, T_off, выход
         ports = new Ports<Type>(3, 1);
         register_ports(ports);
+        toggleFlag(TIMER);
+    }
+
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &DelayOnOffDynamic::ports);
     }
 
     void compute() const override {
@@ -44,54 +49,54 @@ public:
         if (x_changed) {
             if (ports->outputs[0] != 0) {
                 if (prev_x) {
-                    if (T_off < context.time || T_on <= context.time) {
-                        T_off            = context.time + static_cast<Time>(current_T_off * Context::sec);
+                    if (T_off < context->time || T_on <= context->time) {
+                        T_off            = context->time + static_cast<Time>(current_T_off * Context::sec);
                         timer_off_active = true;
                     }
                     T_on            = std::numeric_limits<Time>::max();
                     timer_on_active = false;
                 }
                 else {
-                    T_on            = context.time + static_cast<Time>(current_T_on * Context::sec);
+                    T_on            = context->time + static_cast<Time>(current_T_on * Context::sec);
                     timer_on_active = true;
                 }
             }
             else {
                 T_on = prev_x
                            ? std::numeric_limits<Time>::max()
-                           : context.time + static_cast<Time>(current_T_on * Context::sec);
+                           : context->time + static_cast<Time>(current_T_on * Context::sec);
                 timer_on_active = !prev_x;
             }
         }
         else {
             // Обработка изменения T_on при активном таймере включения
             if (T_on_changed && timer_on_active && T_on != std::numeric_limits<Time>::max()) {
-                Time remaining = T_on - context.time;
+                Time remaining = T_on - context->time;
                 Time new_total = static_cast<Time>(current_T_on * Context::sec);
                 if (remaining > 0) {
                     // Пересчитываем T_on на основе нового времени
                     Time elapsed = static_cast<Time>(prev_T_on * Context::sec) - remaining;
                     if (elapsed < new_total) {
-                        T_on = context.time + (new_total - elapsed);
+                        T_on = context->time + (new_total - elapsed);
                     }
                     else {
-                        T_on = context.time; // Таймер уже должен был сработать
+                        T_on = context->time; // Таймер уже должен был сработать
                     }
                 }
             }
 
             // Обработка изменения T_off при активном таймере выключения
             if (T_off_changed && timer_off_active && T_off != std::numeric_limits<Time>::min()) {
-                Time remaining = T_off - context.time;
+                Time remaining = T_off - context->time;
                 Time new_total = static_cast<Time>(current_T_off * Context::sec);
                 if (remaining > 0) {
                     // Пересчитываем T_off на основе нового времени
                     Time elapsed = static_cast<Time>(prev_T_off * Context::sec) - remaining;
                     if (elapsed < new_total) {
-                        T_off = context.time + (new_total - elapsed);
+                        T_off = context->time + (new_total - elapsed);
                     }
                     else {
-                        T_off = context.time; // Таймер уже должен был сработать
+                        T_off = context->time; // Таймер уже должен был сработать
                     }
                 }
             }
@@ -102,11 +107,15 @@ public:
         prev_T_off = current_T_off;
 
         // Обновляем состояние таймеров
-        timer_on_active  = T_on != std::numeric_limits<Time>::max() && context.time < T_on;
-        timer_off_active = T_off != std::numeric_limits<Time>::min() && context.time < T_off;
+        timer_on_active  = T_on != std::numeric_limits<Time>::max() && context->time < T_on;
+        timer_off_active = T_off != std::numeric_limits<Time>::min() && context->time < T_off;
 
         // Выход = 1, если текущее время >= T_on или текущее время < T_off
-        ports->outputs[0] = context.time >= T_on || context.time < T_off;
+        ports->outputs[0] = context->time >= T_on || context->time < T_off;
+    }
+
+    types::time deadline() const override {
+        return upcoming({T_on, T_off});
     }
 
     std::string printMemory() const override {
@@ -131,6 +140,10 @@ public:
         return line.str();
     }
 
+    void visitState(const StateVisitor& visit) const override {
+        visit_state(visit, T_on, T_off, prev_x, prev_T_on, prev_T_off, timer_on_active, timer_off_active);
+    }
+
     types::string printSource() const override {
         const auto type        = CODE_NAME_TYPE(Time);
         const auto x           = CODE_NAME_IN(ports, 0);
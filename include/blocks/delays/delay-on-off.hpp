@@ -9,11 +9,12 @@
 #include <cmath>
 
 namespace nrcki {
+template <typename Logic = types::real>
 class DelayOnOff final : public Block {
     using Type = types::real;
     using Time = types::time;
 
-    Ports<Type>* ports;
+    Ports<Logic>* ports;
 
     const Time P_on, P_off;
     mutable Time T_on, T_off;
@@ -26,29 +27,38 @@ public:
         P_off(static_cast<Time>(T_off * Context::sec)),
         T_on(std::numeric_limits<Time>::max()),
         T_off(std::numeric_limits<Time>::min()) {
-        ports = new Ports<Type>(1, 1);
+        ports = new Ports<Logic>(1, 1);
         register_ports(ports);
+        toggleFlag(TIMER);
+    }
+
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &DelayOnOff::ports);
     }
 
     void compute() const override {
         if (prev_x != (*ports->inputs[0] != 0)) {
             if (ports->outputs[0] != 0) {
                 if (prev_x) {
-                    if (T_off < context.time || T_on <= context.time)
-                        T_off = context.time + P_off;
+                    if (T_off < context->time || T_on <= context->time)
+                        T_off = context->time + P_off;
                     T_on = std::numeric_limits<Time>::max();
                 }
                 else {
-                    T_on = context.time + P_on;
+                    T_on = context->time + P_on;
                 }
             }
             else {
-                T_on = prev_x ? std::numeric_limits<Time>::max() : context.time + P_on;
+                T_on = prev_x ? std::numeric_limits<Time>::max() : context->time + P_on;
             }
         }
 
         prev_x            = *ports->inputs[0] != 0;
-        ports->outputs[0] = context.time >= T_on || context.time < T_off;
+        ports->outputs[0] = context->time >= T_on || context->time < T_off;
+    }
+
+    types::time deadline() const override {
+        return upcoming({T_on, T_off});
     }
 
     std::string printMemory() const override {
@@ -65,6 +75,10 @@ public:
         return line.str();
     }
 
+    void visitState(const StateVisitor& visit) const override {
+        visit_state(visit, T_on, T_off, prev_x);
+    }
+
     types::string printSource() const override {
         const auto x   = CODE_NAME_IN(ports, 0);
         const auto y   = CODE_NAME_OUT(ports, 0);
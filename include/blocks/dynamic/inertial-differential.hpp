@@ -3,16 +3,22 @@
 #include "constants/config.hxx"
 
 #include "block.h"
+#include "kernels.hpp"
 #include "ports.hpp"
+#include "tape.hpp"
 
+#include <cmath>
+#include <iomanip>
+#include <limits>
 #include <sstream>
 
 namespace nrcki {
+template <typename Type = types::real>
 class InertialDifferential final : public Block {
-    using Type = types::real;
 
     Ports<Type>* ports;
     const Type k, T, y0;
+    Type c_x = 0, c_y = 0; // Дискретные коэффициенты: y += c_x * (x - prev_x) - c_y * y
     mutable Type prev_x = 0;
 
 public:
@@ -21,6 +27,35 @@ public:
         k(k), T(T), y0(y0) {
         ports = new Ports<Type>(1, 1);
         register_ports(ports);
+        discretize();
+    }
+
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &InertialDifferential::ports);
+    }
+
+    // W(s) = k * s / (T * s + 1): Эйлер - k / T, dt / T; точное решение - скачок входа затухает на шаге
+    template <typename V>
+    static void coefficients(const Discretization method, const types::real h, const V& gain, const V& time,
+                             V& x_coefficient, V& y_coefficient) {
+        y_coefficient = discretization::firstOrder(method, h, time);
+        switch (method) {
+            case Discretization::ZeroOrderHold:
+                x_coefficient = gain / time * (1 - y_coefficient);
+                break;
+            case Discretization::Tustin:
+                x_coefficient = 2 * gain / (2 * time + h);
+                break;
+            default:
+                x_coefficient = gain / time;
+                break;
+        }
+    }
+
+    void discretize() override {
+        types::real x_coefficient, y_coefficient;
+        coefficients<types::real>(context->discretization, step_sec(), k, T, x_coefficient, y_coefficient);
+        c_x = x_coefficient, c_y = y_coefficient;
     }
 
     void init() const override {
@@ -29,8 +64,43 @@ public:
     }
 
     void compute() const override {
-        ports->outputs[0] += (k * (*ports->inputs[0] - prev_x) - ports->outputs[0] * Context::dt_sec) / T;
-        prev_x            = *ports->inputs[0];
+        ports->outputs[0] = kernels::inertialDifferential(ports->outputs[0], prev_x, c_x, c_y, *ports->inputs[0]);
+    }
+
+    bool isSteady(const types::real tolerance) const override {
+        const auto y = ports->outputs[0];
+        auto next_x  = prev_x;
+        return std::abs(kernels::inertialDifferential(y, next_x, c_x, c_y, *ports->inputs[0]) - y) <= tolerance &&
+               std::abs(next_x - prev_x) <= tolerance;
+    }
+
+    void visitState(const StateVisitor& visit) const override {
+        visit_state(visit, prev_x);
+    }
+
+    bool lower(Tape& tape) const override {
+        return tape.emit(Tape::Op::InertialDifferential, this, ports, {c_x, c_y}, {&prev_x});
+    }
+
+    // Параметры: [k, T, y0]
+    std::vector<types::real> getParameters() const override {
+        return {k, T, y0};
+    }
+
+    template <typename V>
+    void lower_values(const V* values, V* params, V* output, V*) const {
+        coefficients(context->discretization, step_sec(), values[0], values[1], params[0], params[1]);
+        if (output)
+            *output = values[2];
+    }
+
+    void lowerTangent(const Tangent* values, Tangent* params, Tangent* output, Tangent* state) const override {
+        lower_values(values, params, output, state);
+    }
+
+    void lowerValues(const types::real* values, types::real* params, types::real* output,
+                     types::real* state) const override {
+        lower_values(values, params, output, state);
     }
 
     std::string printMemory() const override {
@@ -59,7 +129,8 @@ public:
         REGISTER_VAR(prev_x)
 
         std::stringstream line;
-        line << y << " += (" << k << " * (" << x << " - " << var_prev_x << ") - " << y << " * dt_sec) / " << T << ";\n";
+        line << std::setprecision(std::numeric_limits<Type>::max_digits10);
+        line << y << " += " << c_x << " * (" << x << " - " << var_prev_x << ") - " << c_y << " * " << y << ";\n";
         line << var_prev_x << " = " << x << ';';
         return line.str();
     }
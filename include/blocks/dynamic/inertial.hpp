@@ -3,16 +3,22 @@
 #include "constants/config.hxx"
 
 #include "block.h"
+#include "kernels.hpp"
 #include "ports.hpp"
+#include "tape.hpp"
 
+#include <cmath>
+#include <iomanip>
+#include <limits>
 #include <sstream>
 
 namespace nrcki {
+template <typename Type = types::real>
 class Inertial final : public Block {
-    using Type = types::real;
 
     Ports<Type>* ports;
     const Type k, T, y0;
+    Type a = 0; // Дискретный коэффициент: y += (k * x - y) * a (dt / T для метода Эйлера)
 
 public:
     explicit Inertial(const Context& context, const Type& k, const Type& T, const Type y0) :
@@ -23,6 +29,15 @@ public:
 
         toggleFlag(CAN_UNTIE_LOOP);
         toggleFlag(IMPLICIT_COMPUTE);
+        discretize();
+    }
+
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &Inertial::ports);
+    }
+
+    void discretize() override {
+        a = discretization::firstOrder(context->discretization, step_sec(), types::real{T});
     }
 
     void init() const override {
@@ -30,7 +45,38 @@ public:
     }
 
     void compute() const override {
-        ports->outputs[0] += (k * (*ports->inputs[0]) - ports->outputs[0]) / T * Context::dt_sec;
+        ports->outputs[0] = kernels::inertial(ports->outputs[0], k, a, *ports->inputs[0]);
+    }
+
+    bool isSteady(const types::real tolerance) const override {
+        const auto y = ports->outputs[0];
+        return std::abs(kernels::inertial(y, k, a, *ports->inputs[0]) - y) <= tolerance;
+    }
+
+    bool lower(Tape& tape) const override {
+        return tape.emit(Tape::Op::Inertial, this, ports, {k, a});
+    }
+
+    // Параметры: [k, T, y0]
+    std::vector<types::real> getParameters() const override {
+        return {k, T, y0};
+    }
+
+    template <typename V>
+    void lower_values(const V* values, V* params, V* output, V*) const {
+        params[0] = values[0];
+        params[1] = discretization::firstOrder(context->discretization, step_sec(), values[1]);
+        if (output)
+            *output = values[2];
+    }
+
+    void lowerTangent(const Tangent* values, Tangent* params, Tangent* output, Tangent* state) const override {
+        lower_values(values, params, output, state);
+    }
+
+    void lowerValues(const types::real* values, types::real* params, types::real* output,
+                     types::real* state) const override {
+        lower_values(values, params, output, state);
     }
 
     std::string printInit() const override {
@@ -45,8 +91,10 @@ public:
         const auto x = CODE_NAME_IN(ports, 0);
         const auto y = CODE_NAME_OUT(ports, 0);
 
+        // Коэффициент уже дискретизован, как и на ленте: печатаем его без потери точности
         std::stringstream line;
-        line << y << " += " << k << " * (" << x << " - " << y << ") / " << T << " * dt_sec;";
+        line << std::setprecision(std::numeric_limits<Type>::max_digits10);
+        line << y << " += (" << k << " * " << x << " - " << y << ") * " << a << ';';
         return line.str();
     }
 };
@@ -3,16 +3,20 @@
 #include "constants/config.hxx"
 
 #include "block.h"
+#include "kernels.hpp"
 #include "ports.hpp"
+#include "tape.hpp"
 
+#include <cmath>
 #include <sstream>
 
 namespace nrcki {
+template <typename Type = types::real>
 class Integrator final : public Block {
-    using Type = types::real;
 
     Ports<Type>* ports;
     const Type k, y0;
+    Type k_dt = 0; // Дискретный коэффициент: k * dt
 
 public:
     explicit Integrator(const Context& context, const Type& k, const Type& y0) :
@@ -23,6 +27,15 @@ public:
 
         toggleFlag(CAN_UNTIE_LOOP);
         toggleFlag(IMPLICIT_COMPUTE);
+        discretize();
+    }
+
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &Integrator::ports);
+    }
+
+    void discretize() override {
+        k_dt = k * step_sec(); // Для удерживаемого на шаге входа точен при любом методе дискретизации
     }
 
     void init() const override {
@@ -30,7 +43,37 @@ public:
     }
 
     void compute() const override {
-        ports->outputs[0] += k * (*ports->inputs[0]) * Context::dt_sec;
+        ports->outputs[0] = kernels::integrator(ports->outputs[0], k_dt, *ports->inputs[0]);
+    }
+
+    bool isSteady(const types::real tolerance) const override {
+        const auto y = ports->outputs[0];
+        return std::abs(kernels::integrator(y, k_dt, *ports->inputs[0]) - y) <= tolerance;
+    }
+
+    bool lower(Tape& tape) const override {
+        return tape.emit(Tape::Op::Integrator, this, ports, {k_dt});
+    }
+
+    // Параметры: [k, y0]
+    std::vector<types::real> getParameters() const override {
+        return {k, y0};
+    }
+
+    template <typename V>
+    void lower_values(const V* values, V* params, V* output, V*) const {
+        params[0] = values[0] * step_sec();
+        if (output)
+            *output = values[1];
+    }
+
+    void lowerTangent(const Tangent* values, Tangent* params, Tangent* output, Tangent* state) const override {
+        lower_values(values, params, output, state);
+    }
+
+    void lowerValues(const types::real* values, types::real* params, types::real* output,
+                     types::real* state) const override {
+        lower_values(values, params, output, state);
     }
 
     std::string printInit() const override {
@@ -3,16 +3,22 @@
 #include "constants/config.hxx"
 
 #include "block.h"
+#include "kernels.hpp"
 #include "ports.hpp"
+#include "tape.hpp"
 
+#include <cmath>
+#include <iomanip>
+#include <limits>
 #include <sstream>
 
 namespace nrcki {
+template <typename Type = types::real>
 class Oscillatory final : public Block {
-    using Type = types::real;
 
     Ports<Type>* ports;
     const Type k, T, b, y0, dy0;
+    discretization::StateSpace2<> model{}; // Дискретная модель: [y, dy] = phi * [y, dy] + gamma * x
     mutable Type dy, prev_y;
 
 public:
@@ -30,6 +36,24 @@ public:
 
         toggleFlag(CAN_UNTIE_LOOP);
         toggleFlag(IMPLICIT_COMPUTE);
+        discretize();
+    }
+
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &Oscillatory::ports);
+    }
+
+    // T² * y'' + 2bT * y' + y = k * x в пространстве состояний [y, dy]
+    template <typename V>
+    static discretization::StateSpace2<V> model_of(const Discretization method, const types::real h,
+                                                   const V& gain, const V& time, const V& damping) {
+        const V a[2][2] = {{0, 1}, {-1 / (time * time), -2 * damping / time}};
+        const V u[2]    = {0, gain / (time * time)};
+        return discretization::secondOrder(method, a, u, h);
+    }
+
+    void discretize() override {
+        model = model_of<types::real>(context->discretization, step_sec(), k, T, b);
     }
 
     void init() const override {
@@ -37,9 +61,53 @@ public:
     }
 
     void compute() const override {
-        prev_y            = ports->outputs[0];
-        ports->outputs[0] += dy * Context::dt_sec;
-        dy                += (k * *ports->inputs[0] - 2 * b * T * dy - prev_y) / (T * T) * Context::dt_sec;
+        const auto& [phi, gamma] = model;
+        ports->outputs[0]        = kernels::oscillatory(ports->outputs[0], dy, prev_y, phi[0][0], phi[0][1], phi[1][0],
+                                                        phi[1][1], gamma[0], gamma[1], *ports->inputs[0]);
+    }
+
+    bool isSteady(const types::real tolerance) const override {
+        const auto& [phi, gamma] = model;
+        const auto y             = ports->outputs[0];
+        auto next_dy             = dy;
+        auto next_prev_y         = prev_y;
+        const auto next          = kernels::oscillatory(y, next_dy, next_prev_y, phi[0][0], phi[0][1], phi[1][0],
+                                                        phi[1][1], gamma[0], gamma[1], *ports->inputs[0]);
+        return std::abs(next - y) <= tolerance && std::abs(next_dy - dy) <= tolerance &&
+               std::abs(next_prev_y - prev_y) <= tolerance;
+    }
+
+    void visitState(const StateVisitor& visit) const override {
+        visit_state(visit, dy, prev_y);
+    }
+
+    bool lower(Tape& tape) const override {
+        return tape.emit(Tape::Op::Oscillatory, this, ports, {
+            model.phi[0][0], model.phi[0][1], model.phi[1][0], model.phi[1][1], model.gamma[0], model.gamma[1]
+        }, {&dy, &prev_y});
+    }
+
+    // Параметры: [k, T, b, y0, dy0]
+    std::vector<types::real> getParameters() const override {
+        return {k, T, b, y0, dy0};
+    }
+
+    template <typename V>
+    void lower_values(const V* values, V* params, V* output, V* state) const {
+        const auto [phi, gamma] = model_of(context->discretization, step_sec(), values[0], values[1], values[2]);
+        params[0] = phi[0][0], params[1] = phi[0][1], params[2] = phi[1][0], params[3] = phi[1][1];
+        params[4] = gamma[0], params[5] = gamma[1];
+        if (output)
+            *output = values[3], state[0] = values[4];
+    }
+
+    void lowerTangent(const Tangent* values, Tangent* params, Tangent* output, Tangent* state) const override {
+        lower_values(values, params, output, state);
+    }
+
+    void lowerValues(const types::real* values, types::real* params, types::real* output,
+                     types::real* state) const override {
+        lower_values(values, params, output, state);
     }
 
     std::string printMemory() const override {
@@ -68,12 +136,15 @@ public:
         REGISTER_VAR(dy)
         REGISTER_VAR(prev_y)
 
+        const auto& [phi, gamma] = model;
+
         std::stringstream line;
+        line << std::setprecision(std::numeric_limits<Type>::max_digits10);
         line << var_prev_y << " = " << y << ";\n";
-        line << y << " += " << var_dy << " * dt_sec;\n";
-        line << var_dy << " += (" << k << " * " << x << " - " << 2 * b * T << " * " << var_dy << " - " << var_prev_y <<
-            ") / "
-            << T * T << " * dt_sec;";
+        line << y << " = " << phi[0][0] << " * " << var_prev_y << " + " << phi[0][1] << " * " << var_dy << " + "
+             << gamma[0] << " * " << x << ";\n";
+        line << var_dy << " = " << phi[1][0] << " * " << var_prev_y << " + " << phi[1][1] << " * " << var_dy << " + "
+             << gamma[1] << " * " << x << ';';
         return line.str();
     }
 };
@@ -3,13 +3,16 @@
 #include "constants/config.hxx"
 
 #include "block.h"
+#include "kernels.hpp"
 #include "ports.hpp"
+#include "tape.hpp"
 
+#include <cmath>
 #include <sstream>
 
 namespace nrcki {
+template <typename Type = types::real>
 class StepDelay final : public Block {
-    using Type = types::real;
 
     Ports<Type>* ports;
     const Type y0;
@@ -25,14 +28,29 @@ public:
         toggleFlag(CAN_UNTIE_LOOP);
     }
 
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &StepDelay::ports);
+    }
+
     void init() const override {
         ports->outputs[0] = y0;
         prev_x            = *ports->inputs[0];
     }
 
     void compute() const override {
-        ports->outputs[0] = prev_x;
-        prev_x            = *ports->inputs[0];
+        ports->outputs[0] = kernels::stepDelay(prev_x, *ports->inputs[0]);
+    }
+
+    bool isSteady(const types::real tolerance) const override {
+        return std::abs(ports->outputs[0] - prev_x) <= tolerance && std::abs(prev_x - *ports->inputs[0]) <= tolerance;
+    }
+
+    void visitState(const StateVisitor& visit) const override {
+        visit_state(visit, prev_x);
+    }
+
+    bool lower(Tape& tape) const override {
+        return tape.emit(Tape::Op::StepDelay, this, ports, {}, {&prev_x});
     }
 
     std::string printMemory() const override {
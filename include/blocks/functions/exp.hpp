@@ -20,6 +20,10 @@ public:
         register_ports(ports);
     }
 
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &Exp::ports);
+    }
+
     void compute() const override {
         ports->outputs[0] = std::exp(*ports->inputs[0]);
     }
@@ -22,6 +22,10 @@ public:
         register_ports(ports);
     }
 
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &Hyperbolic::ports);
+    }
+
     void compute() const override {
         ports->outputs[0] = k / *ports->inputs[0];
     }
@@ -20,6 +20,10 @@ public:
         register_ports(ports);
     }
 
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &MinValueComp::ports);
+    }
+
     void compute() const override {
         ports->outputs[1] = *ports->inputs[0] > *ports->inputs[1];
         ports->outputs[0] = static_cast<bool>(ports->outputs[1]) ? *ports->inputs[0] : *ports->inputs[1];
@@ -21,6 +21,10 @@ public:
         register_ports(ports);
     }
 
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &Sqrt::ports);
+    }
+
     void compute() const override {
         ports->outputs[0] = std::sqrt(*ports->inputs[0]);
     }
@@ -31,6 +31,10 @@ public:
         register_ports(ports);
     }
 
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &InterPoly4::ports);
+    }
+
     void compute() const override {
         const auto x      = 2 * (*ports->inputs[0] - x1) / dx - 1;
         ports->outputs[0] = ((((C[4] * x) + C[3]) * x + C[2]) * x + C[1]) * x + C[0];
@@ -4,6 +4,7 @@
 
 #include "block.h"
 #include "ports.hpp"
+#include "tape.hpp"
 
 #include <sstream>
 #include <utility>
@@ -11,8 +12,8 @@
 #include "plc-code.hpp"
 
 namespace nrcki {
+template <typename Type = types::real>
 class PiecewiseLinear final : public Block {
-    using Type = types::real;
     using Vec  = std::vector<Type>;
 
     Ports<Type>* ports;
@@ -23,18 +24,69 @@ class PiecewiseLinear final : public Block {
     PiecewiseLinearCharacteristic bsc;
 
 public:
-    explicit PiecewiseLinear(const Context& context, const Vec& x, const Vec& y, bool is_extra_bound) :
+    explicit PiecewiseLinear(const Context& context, const std::vector<types::real>& x, const std::vector<types::real>& y,
+                             bool is_extra_bound) :
         Block(context),
         bsc(x, y, is_extra_bound),
         n(x.size()), is_extra_bound(is_extra_bound) {
         ports = new Ports<Type>(1, 1);
         register_ports(ports);
+        toggleFlag(EVENT_DRIVEN);
+    }
+
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &PiecewiseLinear::ports);
     }
 
     void compute() const override {
         ports->outputs[0] = bsc(*ports->inputs[0]);
     }
 
+    bool lower(Tape& tape) const override {
+        Vec params{static_cast<Type>(n)};
+        params.insert(params.end(), bsc.getArgs().begin(), bsc.getArgs().end());
+        params.insert(params.end(), bsc.getValues().begin(), bsc.getValues().end());
+        for (const auto& [k, b] : bsc.getCoefficients()) {
+            params.push_back(k);
+            params.push_back(b);
+        }
+
+        const auto op = n < 16
+                            ? is_extra_bound ? Tape::Op::PiecewiseLinearEL : Tape::Op::PiecewiseLinearSL
+                            : is_extra_bound ? Tape::Op::PiecewiseLinearEB : Tape::Op::PiecewiseLinearSB;
+        return tape.emit(op, this, ports, params);
+    }
+
+    // Параметры: узлы [x[n], y[n]]
+    std::vector<types::real> getParameters() const override {
+        std::vector<types::real> nodes(bsc.getArgs().begin(), bsc.getArgs().end());
+        nodes.insert(nodes.end(), bsc.getValues().begin(), bsc.getValues().end());
+        return nodes;
+    }
+
+    // Коэффициенты участков пересчитываются по узлам: производные по x и y переходят в k и b
+    template <typename V>
+    void lower_values(const V* values, V* params, V*, V*) const {
+        const auto x = values, y = values + n;
+        for (std::size_t i = 0; i < n; ++i)
+            params[1 + i] = x[i], params[1 + n + i] = y[i];
+        params[1 + 2 * n + 1] = y[0];
+        for (std::size_t i = 1; i < n; ++i) {
+            const auto k = (y[i] - y[i - 1]) / (x[i] - x[i - 1]);
+            params[1 + 2 * n + 2 * i]     = k;
+            params[1 + 2 * n + 2 * i + 1] = y[i] - x[i] * k;
+        }
+    }
+
+    void lowerTangent(const Tangent* values, Tangent* params, Tangent* output, Tangent* state) const override {
+        lower_values(values, params, output, state);
+    }
+
+    void lowerValues(const types::real* values, types::real* params, types::real* output,
+                     types::real* state) const override {
+        lower_values(values, params, output, state);
+    }
+
     std::string printMemory() const override {
         REGISTER_VAR(bcs)
         std::stringstream line;
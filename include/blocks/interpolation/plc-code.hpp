@@ -1,6 +1,7 @@
 #pragma once
 
 #include "constants/config.hxx"
+#include "kernels.hpp"
 
 #include <vector>
 #include <algorithm>
@@ -11,8 +12,6 @@ class [[maybe_unused]] PiecewiseLinearCharacteristic {
     using Type = types::real;
     using Vec = std::vector <Type>;
 
-    using ComputeFunction = Type (PiecewiseLinearCharacteristic::*)(const Type&) const noexcept;
-
     const Vec args, values;
     const std::size_t n;
     const Type* x;
@@ -21,7 +20,7 @@ class [[maybe_unused]] PiecewiseLinearCharacteristic {
     const std::vector <std::pair <Type, Type>> kb_coeffs;
     const std::pair <Type, Type>* kb;
 
-    const ComputeFunction compute;
+    const bool is_extra_bound, is_binary; // Продолжение крайних участков; двоичный поиск участка (n >= 16)
 
     [[nodiscard]] inline std::vector <std::pair <Type, Type>> compute_kb() const noexcept {
         std::vector <std::pair <Type, Type>> res;
@@ -35,14 +34,15 @@ class [[maybe_unused]] PiecewiseLinearCharacteristic {
         return res;
     }
 
-    [[nodiscard]] inline ComputeFunction auto_select_function(bool is_extra_bound) const noexcept {
-        if (n < 16)
-            return is_extra_bound
-                   ? &PiecewiseLinearCharacteristic::compute_EL
-                   : &PiecewiseLinearCharacteristic::compute_SL;
-        return is_extra_bound
-               ? &PiecewiseLinearCharacteristic::compute_EB
-               : &PiecewiseLinearCharacteristic::compute_SB;
+    /// Расчёт через ядро kernels::piecewiseLinear; V - скаляр или дуальное число
+    template <typename V>
+    [[nodiscard]] inline V evaluate(const V& in, const bool extra, const bool binary) const noexcept {
+        return kernels::piecewiseLinear(in, n,
+                                        [this](const std::size_t i) { return x[i]; },
+                                        [this](const std::size_t i) { return y[i]; },
+                                        [this](const std::size_t i) { return kb[i].first; },
+                                        [this](const std::size_t i) { return kb[i].second; },
+                                        extra, binary);
     }
 
     public:
@@ -50,82 +50,55 @@ class [[maybe_unused]] PiecewiseLinearCharacteristic {
             args(std::move(x)), values(std::move(y)), n(args.size()),
             x(args.data()), y(values.data()),
             kb_coeffs(compute_kb()), kb(kb_coeffs.data()),
-            compute(auto_select_function(is_extra_bound)) {
+            is_extra_bound(is_extra_bound), is_binary(n >= 16) {
     }
 
     [[maybe_unused]] PiecewiseLinearCharacteristic(const Vec& x, const Vec& y, bool is_extra_bound = false) noexcept :
             args(x), values(y), n(args.size()),
             x(args.data()), y(values.data()),
             kb_coeffs(compute_kb()), kb(kb_coeffs.data()),
-            compute(auto_select_function(is_extra_bound)) {
+            is_extra_bound(is_extra_bound), is_binary(n >= 16) {
     }
 
-    [[nodiscard]] inline Type operator()(const Type& in) const noexcept {
-        return (this->*compute)(in);
+    // Копия с собственными таблицами: указатели x, y, kb ссылаются на копируемые векторы
+    PiecewiseLinearCharacteristic(const PiecewiseLinearCharacteristic& other) noexcept :
+            args(other.args), values(other.values), n(other.n),
+            x(args.data()), y(values.data()),
+            kb_coeffs(other.kb_coeffs), kb(kb_coeffs.data()),
+            is_extra_bound(other.is_extra_bound), is_binary(other.is_binary) {
     }
 
-    [[nodiscard]] inline Type compute_SL(const Type& in) const noexcept {
-        if (in <= x[0])
-            return y[0];
-
-        if (in >= x[n - 1])
-            return y[n - 1];
-
-        for (std::size_t i = 1; i < n; ++i)
-            if (in <= x[i]) {
-                const auto& [k, b] = kb[i];
-                return k * in + b;
-            }
+    template <typename V>
+    [[nodiscard]] inline V operator()(const V& in) const noexcept {
+        return evaluate(in, is_extra_bound, is_binary);
+    }
 
-        return 0;
+    [[nodiscard]] inline Type compute_SL(const Type& in) const noexcept {
+        return evaluate(in, false, false);
     }
 
     [[nodiscard]] inline Type compute_EL(const Type& in) const noexcept {
-        if (in <= x[0]) {
-            const auto& [k, b] = kb[1];
-            return k * in + b;
-        }
-
-        if (in >= x[n - 1]) {
-            const auto& [k, b] = kb[n - 1];
-            return k * in + b;
-        }
-
-        for (std::size_t i = 1; i < n; ++i)
-            if (in < x[i]) {
-                const auto& [k, b] = kb[i];
-                return k * in + b;
-            }
-
-        return 0;
+        return evaluate(in, true, false);
     }
 
     [[nodiscard]] inline Type compute_SB(const Type& in) const noexcept {
-        if (in <= x[0])
-            return y[0];
-
-        if (in >= x[n - 1])
-            return y[n - 1];
-
-        const std::size_t i = std::upper_bound(x + 1, x + n, in) - x;
-        const auto& [k, b] = kb[i];
-        return k * in + b;
+        return evaluate(in, false, true);
     }
 
     [[nodiscard]] inline Type compute_EB(const Type& in) const noexcept {
-        if (in <= x[0]) {
-            const auto& [k, b] = kb[1];
-            return k * in + b;
-        }
+        return evaluate(in, true, true);
+    }
 
-        if (in >= x[n - 1]) {
-            const auto& [k, b] = kb[n - 1];
-            return k * in + b;
-        }
+    [[nodiscard]] inline const Vec& getArgs() const noexcept {
+        return args;
+    }
+
+    [[nodiscard]] inline const Vec& getValues() const noexcept {
+        return values;
+    }
 
-        const std::size_t i = std::upper_bound(x + 1, x + n, in) - x;
-        const auto& [k, b] = kb[i];
-        return k * in + b;
+    [[nodiscard]] inline const std::vector <std::pair <Type, Type>>& getCoefficients() const noexcept {
+        return kb_coeffs;
     }
 
     [[nodiscard]] inline std::string getX() const noexcept {
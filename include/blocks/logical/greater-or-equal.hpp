@@ -4,31 +4,41 @@
 
 #include "block.h"
 #include "ports.hpp"
+#include "tape.hpp"
 
 #include <sstream>
 
 namespace nrcki {
+template <typename Logic = types::real, typename Type = types::real>
 class GreaterOrEqual final : public Block {
-    using Type = types::real;
     using size = types::size;
 
-    Ports<Type>* ports;
+    Ports<Type>* ports; // Входы (в вещественном режиме - и выход)
+    Ports<Logic>* out;
 
 public:
     explicit GreaterOrEqual(const Context& context) :
         Block(context) {
-        ports = new Ports<Type>(2, 1);
-        register_ports(ports);
+        register_ports(2, 1, ports, out);
+        toggleFlag(EVENT_DRIVEN);
+    }
+
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &GreaterOrEqual::ports, &GreaterOrEqual::out);
     }
 
     void compute() const override {
-        ports->outputs[0] = *ports->inputs[0] >= *ports->inputs[1];
+        out->outputs[0] = *ports->inputs[0] >= *ports->inputs[1];
+    }
+
+    bool lower(Tape& tape) const override {
+        return tape.emit(Tape::Op::GreaterOrEqual, this, out); // В вещественном режиме out и ports - одни порты
     }
 
     types::string printSource() const override {
         const auto x1 = CODE_NAME_IN(ports, 0);
         const auto x2 = CODE_NAME_IN(ports, 1);
-        const auto y  = CODE_NAME_OUT(ports, 0);
+        const auto y  = CODE_NAME_OUT(out, 0);
 
         std::stringstream line;
         line << y << " = " << x1 << " >= " << x2 << ';';
@@ -36,8 +46,8 @@ public:
     }
 
     bool tryMakeConstant() override {
-        if (context.ports_info[ports->inputs[0]].is_constant && context.ports_info[ports->inputs[1]].is_constant) {
-            context.ports_info[&ports->outputs[0]].is_constant = true;
+        if (context->ports_info[ports->inputs[0]].is_constant && context->ports_info[ports->inputs[1]].is_constant) {
+            context->ports_info[&out->outputs[0]].is_constant = true;
             toggleFlag(Block::FlagType::CONSTANT);
             return true;
         }
@@ -4,27 +4,37 @@
 
 #include "block.h"
 #include "ports.hpp"
+#include "tape.hpp"
 
 #include <sstream>
 
 namespace nrcki {
+template <typename Logic = types::real>
 class Not final : public Block {
-    using Type = types::real;
     using size = types::size;
 
-    Ports<Type>* ports;
+    Ports<Logic>* ports;
 
 public:
     explicit Not(const Context& context) :
         Block(context) {
-        ports = new Ports<Type>(1, 1);
+        ports = new Ports<Logic>(1, 1);
         register_ports(ports);
+        toggleFlag(EVENT_DRIVEN);
+    }
+
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &Not::ports);
     }
 
     void compute() const override {
         ports->outputs[0] = *ports->inputs[0] == 0;
     }
 
+    bool lower(Tape& tape) const override {
+        return tape.emit(Tape::Op::Not, this, ports);
+    }
+
     types::string printSource() const override {
         const auto x = CODE_NAME_IN(ports, 0);
         const auto y = CODE_NAME_OUT(ports, 0);
@@ -35,8 +45,8 @@ public:
     }
 
     bool tryMakeConstant() override {
-        if (context.ports_info[ports->inputs[0]].is_constant) {
-            context.ports_info[&ports->outputs[0]].is_constant = true;
+        if (context->ports_info[ports->inputs[0]].is_constant) {
+            context->ports_info[&ports->outputs[0]].is_constant = true;
             toggleFlag(Block::FlagType::CONSTANT);
             return true;
         }
@@ -4,21 +4,27 @@
 
 #include "block.h"
 #include "ports.hpp"
+#include "tape.hpp"
 
 #include <sstream>
 
 namespace nrcki {
+template <typename Logic = types::real>
 class Or final : public Block {
-    using Type = types::real;
     using size = types::size;
 
-    Ports<Type>* ports;
+    Ports<Logic>* ports;
 
 public:
     explicit Or(const Context& context, size n) :
         Block(context) {
-        ports = new Ports<Type>(n, 1);
+        ports = new Ports<Logic>(n, 1);
         register_ports(ports);
+        toggleFlag(EVENT_DRIVEN);
+    }
+
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &Or::ports);
     }
 
     void compute() const override {
@@ -30,6 +36,10 @@ public:
             }
     }
 
+    bool lower(Tape& tape) const override {
+        return tape.emit(Tape::Op::Or, this, ports);
+    }
+
     types::string printSource() const override {
         auto x       = CODE_NAME_IN(ports, 0);
         const auto y = CODE_NAME_OUT(ports, 0);
@@ -46,9 +56,9 @@ public:
 
     bool tryMakeConstant() override {
         for (size i = 0; i < ports->input_count; ++i)
-            if (!context.ports_info[ports->inputs[i]].is_constant)
+            if (!context->ports_info[ports->inputs[i]].is_constant)
                 return false;
-        context.ports_info[&ports->outputs[0]].is_constant = true;
+        context->ports_info[&ports->outputs[0]].is_constant = true;
         toggleFlag(Block::FlagType::CONSTANT);
         return true;
     }
@@ -3,13 +3,15 @@
 #include "constants/config.hxx"
 
 #include "block.h"
+#include "kernels.hpp"
 #include "ports.hpp"
+#include "tape.hpp"
 
 #include <sstream>
 
 namespace nrcki {
+template <typename Type = types::real>
 class Deadband final : public Block {
-    using Type = types::real;
 
     Ports<Type>* ports;
 
@@ -21,11 +23,19 @@ public:
         x1(x1), x2(x2), k(k) {
         ports = new Ports<Type>(1, 1);
         register_ports(ports);
+        toggleFlag(EVENT_DRIVEN);
+    }
+
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &Deadband::ports);
     }
 
     void compute() const override {
-        const auto x      = *ports->inputs[0];
-        ports->outputs[0] = x < x1 ? k * (x - x1) : x > x2 ? k * (x - x2) : 0;
+        ports->outputs[0] = kernels::deadband(*ports->inputs[0], x1, x2, k);
+    }
+
+    bool lower(Tape& tape) const override {
+        return tape.emit(Tape::Op::Deadband, this, ports, {x1, x2, k});
     }
 
     types::string printSource() const override {
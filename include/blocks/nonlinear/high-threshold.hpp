@@ -3,13 +3,15 @@
 #include "constants/config.hxx"
 
 #include "block.h"
+#include "kernels.hpp"
 #include "ports.hpp"
+#include "tape.hpp"
 
 #include <sstream>
 
 namespace nrcki {
+template <typename Type = types::real>
 class HighThreshold final : public Block {
-    using Type = types::real;
 
     Ports<Type>* ports;
 
@@ -22,6 +24,11 @@ public:
         deactivation(activation_threshold - deactivation_delta) {
         ports = new Ports<Type>(1, 1);
         register_ports(ports);
+        toggleFlag(EVENT_DRIVEN);
+    }
+
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &HighThreshold::ports);
     }
 
     void init() const override {
@@ -29,11 +36,11 @@ public:
     }
 
     void compute() const override {
-        const auto x = *ports->inputs[0];
-        if (x < deactivation)
-            ports->outputs[0] = false;
-        else if (x > activation)
-            ports->outputs[0] = true;
+        ports->outputs[0] = kernels::highThreshold(*ports->inputs[0], activation, deactivation, ports->outputs[0]);
+    }
+
+    bool lower(Tape& tape) const override {
+        return tape.emit(Tape::Op::HighThreshold, this, ports, {activation, deactivation});
     }
 
     types::string printInit() const override {
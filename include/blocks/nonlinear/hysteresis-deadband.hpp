@@ -8,8 +8,8 @@
 #include <sstream>
 
 namespace nrcki {
+template <typename Type = types::real>
 class HysteresisDeadband final : public Block {
-    using Type = types::real;
 
     Ports<Type>* ports;
 
@@ -29,6 +29,11 @@ public:
         y0(y0) {
         ports = new Ports<Type>(1, 1);
         register_ports(ports);
+        toggleFlag(EVENT_DRIVEN);
+    }
+
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &HysteresisDeadband::ports);
     }
 
     void init() const override {
@@ -8,8 +8,8 @@
 #include <sstream>
 
 namespace nrcki {
+template <typename Type = types::real>
 class HysteresisDynamic : public Block {
-    using Type = types::real;
 
     Ports<Type>* ports;
 
@@ -24,6 +24,11 @@ public:
         y1(y1), y2(y2), y0(y0) {
         ports = new Ports<Type>(3, 1);
         register_ports(ports);
+        toggleFlag(EVENT_DRIVEN);
+    }
+
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &HysteresisDynamic::ports);
     }
 
     void init() const override {
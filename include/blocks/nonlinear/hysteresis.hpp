@@ -3,13 +3,15 @@
 #include "constants/config.hxx"
 
 #include "block.h"
+#include "kernels.hpp"
 #include "ports.hpp"
+#include "tape.hpp"
 
 #include <sstream>
 
 namespace nrcki {
+template <typename Type = types::real>
 class Hysteresis final : public Block {
-    using Type = types::real;
 
     Ports<Type>* ports;
 
@@ -25,6 +27,11 @@ public:
         x1(x1), x2(x2), y1(y1), y2(y2), y0(y0) {
         ports = new Ports<Type>(1, 1);
         register_ports(ports);
+        toggleFlag(EVENT_DRIVEN);
+    }
+
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &Hysteresis::ports);
     }
 
     void init() const override {
@@ -33,11 +40,11 @@ public:
     }
 
     void compute() const override {
-        const auto x = *ports->inputs[0];
-        if (x <= x1)
-            ports->outputs[0] = y1;
-        else if (x >= x2)
-            ports->outputs[0] = y2;
+        ports->outputs[0] = kernels::hysteresis(*ports->inputs[0], x1, x2, y1, y2, ports->outputs[0]);
+    }
+
+    bool lower(Tape& tape) const override {
+        return tape.emit(Tape::Op::Hysteresis, this, ports, {x1, x2, y1, y2});
     }
 
     types::string printInit() const override {
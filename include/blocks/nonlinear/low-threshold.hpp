@@ -3,13 +3,15 @@
 #include "constants/config.hxx"
 
 #include "block.h"
+#include "kernels.hpp"
 #include "ports.hpp"
+#include "tape.hpp"
 
 #include <sstream>
 
 namespace nrcki {
+template <typename Type = types::real>
 class LowThreshold final : public Block {
-    using Type = types::real;
 
     Ports<Type>* ports;
 
@@ -22,6 +24,11 @@ public:
         deactivation(activation_threshold + deactivation_delta) {
         ports = new Ports<Type>(1, 1);
         register_ports(ports);
+        toggleFlag(EVENT_DRIVEN);
+    }
+
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &LowThreshold::ports);
     }
 
     void init() const override {
@@ -29,11 +36,11 @@ public:
     }
 
     void compute() const override {
-        const auto input = *ports->inputs[0];
-        if (input > deactivation)
-            ports->outputs[0] = false;
-        else if (input < activation)
-            ports->outputs[0] = true;
+        ports->outputs[0] = kernels::lowThreshold(*ports->inputs[0], activation, deactivation, ports->outputs[0]);
+    }
+
+    bool lower(Tape& tape) const override {
+        return tape.emit(Tape::Op::LowThreshold, this, ports, {activation, deactivation});
     }
 
     types::string printInit() const override {
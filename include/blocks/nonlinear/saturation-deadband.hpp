@@ -8,8 +8,8 @@
 #include <sstream>
 
 namespace nrcki {
+template <typename Type = types::real>
 class SaturationDeadband final : public Block {
-    using Type = types::real;
 
     Ports<Type>* ports;
 
@@ -32,6 +32,11 @@ public:
         b2(y2 - k2 * x2) {
         ports = new Ports<Type>(1, 1);
         register_ports(ports);
+        toggleFlag(EVENT_DRIVEN);
+    }
+
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &SaturationDeadband::ports);
     }
 
     void compute() const override {
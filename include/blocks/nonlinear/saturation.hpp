@@ -3,13 +3,15 @@
 #include "constants/config.hxx"
 
 #include "block.h"
+#include "kernels.hpp"
 #include "ports.hpp"
+#include "tape.hpp"
 
 #include <sstream>
 
 namespace nrcki {
+template <typename Type = types::real>
 class Saturation final : public Block {
-    using Type = types::real;
 
     Ports<Type>* ports;
 
@@ -24,12 +26,41 @@ public:
         b(y1 - x1 * k) {
         ports = new Ports<Type>(1, 1);
         register_ports(ports);
+        toggleFlag(EVENT_DRIVEN);
+    }
+
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &Saturation::ports);
     }
 
     void compute() const override {
-        const auto x      = *ports->inputs[0];
-        ports->outputs[0] = x < x1 ? y1 : x > x2 ? y2 : k * x + b;
-        //ports->outputs[0] = x < x1 ? y1 : x > x2 ? y2 : std::fma(k, x, k);
+        ports->outputs[0] = kernels::saturation(*ports->inputs[0], x1, x2, y1, y2, k, b);
+    }
+
+    bool lower(Tape& tape) const override {
+        return tape.emit(Tape::Op::Saturation, this, ports, {x1, x2, y1, y2, k, b});
+    }
+
+    // Параметры: [x1, x2, y1, y2]
+    std::vector<types::real> getParameters() const override {
+        return {x1, x2, y1, y2};
+    }
+
+    template <typename V>
+    void lower_values(const V* values, V* params, V*, V*) const {
+        for (int i = 0; i < 4; ++i)
+            params[i] = values[i];
+        params[4] = (values[3] - values[2]) / (values[1] - values[0]);
+        params[5] = values[2] - values[0] * params[4];
+    }
+
+    void lowerTangent(const Tangent* values, Tangent* params, Tangent* output, Tangent* state) const override {
+        lower_values(values, params, output, state);
+    }
+
+    void lowerValues(const types::real* values, types::real* params, types::real* output,
+                     types::real* state) const override {
+        lower_values(values, params, output, state);
     }
 
     types::string printSource() const override {
@@ -8,8 +8,8 @@
 #include <sstream>
 
 namespace nrcki {
+template <typename Type = types::real>
 class VariableHysteresisMinus final : public Block {
-    using Type = types::real;
 
     Ports<Type>* ports;
     mutable Type prev_y = 0;
@@ -21,6 +21,10 @@ public:
         register_ports(ports);
     }
 
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &VariableHysteresisMinus::ports);
+    }
+
     void init() const override {
         prev_y            = 0;
         ports->outputs[0] = 0;
@@ -36,6 +40,10 @@ public:
         ports->outputs[0] = x <= -100 ? -1 : x >= 100 ? 1 : 0;
     }
 
+    void visitState(const StateVisitor& visit) const override {
+        visit_state(visit, prev_y);
+    }
+
     types::string printInit() const override {
         const auto y = CODE_NAME_OUT(ports, 0);
         REGISTER_VAR(prev_y)
@@ -3,13 +3,15 @@
 #include "constants/config.hxx"
 
 #include "block.h"
+#include "kernels.hpp"
 #include "ports.hpp"
+#include "tape.hpp"
 
 #include <sstream>
 
 namespace nrcki {
+template <typename Type = types::real>
 class Divider final : public Block {
-    using Type = types::real;
     using size = types::size;
 
     Ports<Type>* ports;
@@ -21,10 +23,19 @@ public:
         value_if_div_null(value_if_div_null) {
         ports = new Ports<Type>(2, 1);
         register_ports(ports);
+        toggleFlag(EVENT_DRIVEN);
+    }
+
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &Divider::ports);
     }
 
     void compute() const override {
-        ports->outputs[0] = *ports->inputs[1] != 0 ? *ports->inputs[0] / *ports->inputs[1] : value_if_div_null;
+        ports->outputs[0] = kernels::divider(*ports->inputs[0], *ports->inputs[1], value_if_div_null);
+    }
+
+    bool lower(Tape& tape) const override {
+        return tape.emit(Tape::Op::Divider, this, ports, {value_if_div_null});
     }
 
     types::string printSource() const override {
@@ -38,8 +49,8 @@ public:
     }
 
     bool tryMakeConstant() override {
-        if (context.ports_info[ports->inputs[0]].is_constant && context.ports_info[ports->inputs[1]].is_constant) {
-            context.ports_info[&ports->outputs[0]].is_constant = true;
+        if (context->ports_info[ports->inputs[0]].is_constant && context->ports_info[ports->inputs[1]].is_constant) {
+            context->ports_info[&ports->outputs[0]].is_constant = true;
             toggleFlag(Block::FlagType::CONSTANT);
             return true;
         }
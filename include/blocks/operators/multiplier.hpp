@@ -3,13 +3,15 @@
 #include "constants/config.hxx"
 
 #include "block.h"
+#include "kernels.hpp"
 #include "ports.hpp"
+#include "tape.hpp"
 
 #include <sstream>
 
 namespace nrcki {
+template <typename Type = types::real>
 class Multiplier final : public Block {
-    using Type = types::real;
     using size = types::size;
 
     Ports<Type>* ports;
@@ -19,12 +21,20 @@ public:
         Block(context) {
         ports = new Ports<Type>(n, 1);
         register_ports(ports);
+        toggleFlag(EVENT_DRIVEN);
+    }
+
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &Multiplier::ports);
     }
 
     void compute() const override {
-        ports->outputs[0] = *ports->inputs[0];
-        for (size i = 1; i < ports->input_count; ++i)
-            ports->outputs[0] *= *ports->inputs[i];
+        ports->outputs[0] = kernels::multiplier<Type>(ports->input_count,
+                                                      [this](const size i) { return *ports->inputs[i]; });
+    }
+
+    bool lower(Tape& tape) const override {
+        return tape.emit(Tape::Op::Multiplier, this, ports);
     }
 
     types::string printSource() const override {
@@ -43,9 +53,9 @@ public:
 
     bool tryMakeConstant() override {
         for (size i = 0; i < ports->input_count; ++i)
-            if (!context.ports_info[ports->inputs[i]].is_constant)
+            if (!context->ports_info[ports->inputs[i]].is_constant)
                 return false;
-        context.ports_info[&ports->outputs[0]].is_constant = true;
+        context->ports_info[&ports->outputs[0]].is_constant = true;
         toggleFlag(Block::FlagType::CONSTANT);
         return true;
     }
@@ -3,13 +3,15 @@
 #include "constants/config.hxx"
 
 #include "block.h"
+#include "kernels.hpp"
 #include "ports.hpp"
+#include "tape.hpp"
 
 #include <sstream>
 
 namespace nrcki {
+template <typename Type = types::real>
 class Negate final : public Block {
-    using Type = types::real;
     using size = types::size;
 
     Ports<Type>* ports;
@@ -19,10 +21,19 @@ public:
         Block(context) {
         ports = new Ports<Type>(1, 1);
         register_ports(ports);
+        toggleFlag(EVENT_DRIVEN);
+    }
+
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &Negate::ports);
     }
 
     void compute() const override {
-        ports->outputs[0] = -(*ports->inputs[0]);
+        ports->outputs[0] = kernels::negate(*ports->inputs[0]);
+    }
+
+    bool lower(Tape& tape) const override {
+        return tape.emit(Tape::Op::Negate, this, ports);
     }
 
     types::string printSource() const override {
@@ -35,8 +46,8 @@ public:
     }
 
     bool tryMakeConstant() override {
-        if (context.ports_info[ports->inputs[0]].is_constant) {
-            context.ports_info[&ports->outputs[0]].is_constant = true;
+        if (context->ports_info[ports->inputs[0]].is_constant) {
+            context->ports_info[&ports->outputs[0]].is_constant = true;
             toggleFlag(Block::FlagType::CONSTANT);
             return true;
         }
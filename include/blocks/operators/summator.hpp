@@ -3,30 +3,41 @@
 #include "constants/config.hxx"
 
 #include "block.h"
+#include "kernels.hpp"
 #include "ports.hpp"
+#include "tape.hpp"
 
 #include <sstream>
 
 namespace nrcki {
+template <typename Type = types::real>
 class Summator final : public Block {
-    using Type = types::real;
     using size = types::size;
 
     Ports<Type>* ports;
     const std::vector<Type> coeffs;
 
 public:
-    explicit Summator(const Context& context, const std::vector<Type>& coefficients) :
+    explicit Summator(const Context& context, const std::vector<types::real>& coefficients) :
         Block(context),
-        coeffs(coefficients) {
+        coeffs(coefficients.begin(), coefficients.end()) {
         ports = new Ports<Type>(coefficients.size(), 1);
         register_ports(ports);
+        toggleFlag(EVENT_DRIVEN);
+    }
+
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &Summator::ports);
     }
 
     void compute() const override {
-        ports->outputs[0] = coeffs[0] * (*ports->inputs[0]);
-        for (size i = 1; i < ports->input_count; ++i)
-            ports->outputs[0] += coeffs[i] * (*ports->inputs[i]);
+        ports->outputs[0] = kernels::summator<Type>(ports->input_count,
+                                                    [this](const size i) { return coeffs[i]; },
+                                                    [this](const size i) { return *ports->inputs[i]; });
+    }
+
+    bool lower(Tape& tape) const override {
+        return tape.emit(Tape::Op::Summator, this, ports, coeffs);
     }
 
     types::string printSource() const override {
@@ -45,9 +56,9 @@ public:
 
     bool tryMakeConstant() override {
         for (size i = 0; i < ports->input_count; ++i)
-            if (!context.ports_info[ports->inputs[i]].is_constant)
+            if (!context->ports_info[ports->inputs[i]].is_constant)
                 return false;
-        context.ports_info[&ports->outputs[0]].is_constant = true;
+        context->ports_info[&ports->outputs[0]].is_constant = true;
         toggleFlag(Block::FlagType::CONSTANT);
         return true;
     }
@@ -9,11 +9,12 @@
 #include <sstream>
 
 namespace nrcki {
+template <typename Logic = types::real>
 class DebounceOnOff final : public Block {
     using Type = types::real;
     using Time = types::time;
 
-    Ports<Type>* ports;
+    Ports<Logic>* ports;
 
     const Time T;
     mutable bool prev_x = false;
@@ -25,21 +26,26 @@ public:
         T(static_cast<Time>(T * Context::sec)),
         T_on(std::numeric_limits<Time>::max()),
         T_off(std::numeric_limits<Time>::min()) {
-        ports = new Ports<Type>(1, 1);
+        ports = new Ports<Logic>(1, 1);
         register_ports(ports);
+        toggleFlag(TIMER);
+    }
+
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &DebounceOnOff::ports);
     }
 
     void compute() const override {
         if (prev_x != (*ports->inputs[0] != 0)) {
-            ports->outputs[0] = context.time >= T_on && context.time < T_off;
+            ports->outputs[0] = context->time >= T_on && context->time < T_off;
             if (!prev_x) {
-                T_on  = ports->outputs[0] == 0 ? context.time + T : std::numeric_limits<Time>::min();
+                T_on  = ports->outputs[0] == 0 ? context->time + T : std::numeric_limits<Time>::min();
                 T_off = std::numeric_limits<Time>::max();
             }
             else {
                 if (ports->outputs[0] != 0) {
                     T_on  = std::numeric_limits<Time>::min();
-                    T_off = context.time + T;
+                    T_off = context->time + T;
                 }
                 else {
                     T_on  = std::numeric_limits<Time>::max();
@@ -49,7 +55,11 @@ public:
             prev_x = *ports->inputs[0] != 0;
         }
         else
-            ports->outputs[0] = context.time >= T_on && context.time < T_off;
+            ports->outputs[0] = context->time >= T_on && context->time < T_off;
+    }
+
+    types::time deadline() const override {
+        return upcoming({T_on, T_off});
     }
 
     std::string printMemory() const override {
@@ -66,6 +76,10 @@ public:
         return line.str();
     }
 
+    void visitState(const StateVisitor& visit) const override {
+        visit_state(visit, prev_x, T_on, T_off);
+    }
+
     types::string printSource() const override {
         const auto x   = CODE_NAME_IN(ports, 0);
         const auto y   = CODE_NAME_OUT(ports, 0);
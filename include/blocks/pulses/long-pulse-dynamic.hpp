@@ -27,31 +27,40 @@ public:
         time_start(0) {
         ports = new Ports<Type>(2, 1);
         register_ports(ports);
+        toggleFlag(TIMER);
+    }
+
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &LongPulseDynamic::ports);
     }
 
     void compute() const override {
         // Обнаружение фронта входного сигнала
         if (!prev_x && *ports->inputs[0] != 0) {
-            time_start = context.time;
+            time_start = context->time;
             T_off      = time_start + static_cast<Time>(*ports->inputs[1] * Context::sec);
         }
 
         // Обновление времени окончания импульса при изменении T
-        if (prev_T != *ports->inputs[1] && context.time < T_off) {
-            Time elapsed   = context.time - time_start;
+        if (prev_T != *ports->inputs[1] && context->time < T_off) {
+            Time elapsed   = context->time - time_start;
             Time new_total = static_cast<Time>(*ports->inputs[1] * Context::sec);
 
             if (elapsed < new_total) {
                 T_off = time_start + new_total;
             }
             else {
-                T_off = context.time;
+                T_off = context->time;
             }
         }
 
         prev_x            = *ports->inputs[0] != 0;
         prev_T            = *ports->inputs[1];
-        ports->outputs[0] = context.time < T_off;
+        ports->outputs[0] = context->time < T_off;
+    }
+
+    types::time deadline() const override {
+        return upcoming({T_off});
     }
 
     std::string printMemory() const override {
@@ -70,6 +79,10 @@ public:
         return line.str();
     }
 
+    void visitState(const StateVisitor& visit) const override {
+        visit_state(visit, prev_x, T_off, time_start, prev_T);
+    }
+
     types::string printSource() const override {
         const auto x       = CODE_NAME_IN(ports, 0);
         const auto T_param = CODE_NAME_IN(ports, 1);
@@ -26,20 +26,25 @@ public:
         // Порты: входной сигнал, параметр T (длительность импульса), выход
         ports = new Ports<Type>(2, 1);
         register_ports(ports);
+        toggleFlag(TIMER);
+    }
+
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &PulseDynamic::ports);
     }
 
     void compute() const override {
         const Type current_x = *ports->inputs[0];
         const Type current_T = *ports->inputs[1];
 
-        if (context.time < T_off) {
+        if (context->time < T_off) {
             ports->outputs[0] = true; // Импульс активен
         }
         else {
             if (!prev_x && current_x != 0) {
                 // Фронт входного сигнала - запускаем импульс
                 ports->outputs[0] = true;
-                T_off             = context.time + static_cast<Time>(current_T * Context::sec);
+                T_off             = context->time + static_cast<Time>(current_T * Context::sec);
             }
             else {
                 ports->outputs[0] = false; // Импульс неактивен
@@ -48,25 +53,32 @@ public:
         }
 
         // Обработка изменения T во время активного импульса
-        if (context.time < T_off && prev_T != current_T) {
-            Time remaining = T_off - context.time;
+        if (context->time < T_off && prev_T != current_T) {
+            Time remaining = T_off - context->time;
             Time old_total = static_cast<Time>(prev_T * Context::sec);
             Time elapsed   = old_total - remaining;
             Time new_total = static_cast<Time>(current_T * Context::sec);
 
             if (elapsed < new_total) {
                 // Пересчитываем время окончания импульса
-                T_off = context.time + (new_total - elapsed);
+                T_off = context->time + (new_total - elapsed);
             }
             else {
                 // Новое время импульса меньше уже прошедшего - завершаем импульс
-                T_off = context.time;
+                T_off = context->time;
             }
         }
 
         prev_T = current_T;
     }
 
+    types::time deadline() const override {
+        // Импульс, завершённый уменьшением T, снимается на следующем шаге (как в compute())
+        if (ports->outputs[0] != 0 && T_off <= context->time)
+            return context->time + context->dt;
+        return upcoming({T_off});
+    }
+
     std::string printMemory() const override {
         const auto type = CODE_NAME_TYPE(Time);
         const auto min  = CODE_NAME_MIN(Time);
@@ -81,6 +93,10 @@ public:
         return line.str();
     }
 
+    void visitState(const StateVisitor& visit) const override {
+        visit_state(visit, prev_x, T_off, prev_T);
+    }
+
     types::string printSource() const override {
         const auto x       = CODE_NAME_IN(ports, 0);
         const auto T_param = CODE_NAME_IN(ports, 1);
@@ -9,11 +9,12 @@
 #include <sstream>
 
 namespace nrcki {
+template <typename Logic = types::real>
 class Pulse final : public Block {
     using Type = types::real;
     using Time = types::time;
 
-    Ports<Type>* ports;
+    Ports<Logic>* ports;
 
     const Time T;
     mutable bool prev_x = false;
@@ -24,18 +25,23 @@ public:
         Block(context),
         T(static_cast<Time>(T * Context::sec)),
         T_off(std::numeric_limits<Time>::min()) {
-        ports = new Ports<Type>(1, 1);
+        ports = new Ports<Logic>(1, 1);
         register_ports(ports);
+        toggleFlag(TIMER);
+    }
+
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &Pulse::ports);
     }
 
     void compute() const override {
-        if (context.time < T_off) {
+        if (context->time < T_off) {
             ports->outputs[0] = true;
         }
         else {
             if (!prev_x && *ports->inputs[0] != 0) {
                 ports->outputs[0] = true;
-                T_off             = context.time + T;
+                T_off             = context->time + T;
             }
             else {
                 ports->outputs[0] = false;
@@ -44,6 +50,10 @@ public:
         }
     }
 
+    types::time deadline() const override {
+        return upcoming({T_off});
+    }
+
     std::string printMemory() const override {
         const auto type = CODE_NAME_TYPE(Time);
         const auto min  = CODE_NAME_MIN(Time);
@@ -56,6 +66,10 @@ public:
         return line.str();
     }
 
+    void visitState(const StateVisitor& visit) const override {
+        visit_state(visit, prev_x, T_off);
+    }
+
     types::string printSource() const override {
         const auto x = CODE_NAME_IN(ports, 0);
         const auto y = CODE_NAME_OUT(ports, 0);
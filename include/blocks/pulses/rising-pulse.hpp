@@ -5,21 +5,27 @@
 #include "block.h"
 #include "ports.hpp"
 
+#include <limits>
 #include <sstream>
 
 namespace nrcki {
+template <typename Logic = types::real>
 class RisingPulse final : public Block {
-    using Type = types::real;
 
-    Ports<Type>* ports;
+    Ports<Logic>* ports;
 
     mutable bool prev_x = false;
 
 public:
     explicit RisingPulse(const Context& context) :
         Block(context) {
-        ports = new Ports<Type>(1, 1);
+        ports = new Ports<Logic>(1, 1);
         register_ports(ports);
+        toggleFlag(TIMER);
+    }
+
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &RisingPulse::ports);
     }
 
     void init() const override {
@@ -32,6 +38,11 @@ public:
         prev_x            = *ports->inputs[0] != 0;
     }
 
+    // Импульс длится один шаг: выход сбрасывается на следующем шаге
+    types::time deadline() const override {
+        return ports->outputs[0] != 0 ? context->time + 1 : std::numeric_limits<types::time>::max();
+    }
+
     std::string printMemory() const override {
         REGISTER_VAR(prev_x)
 
@@ -51,6 +62,10 @@ public:
         return line.str();
     }
 
+    void visitState(const StateVisitor& visit) const override {
+        visit_state(visit, prev_x);
+    }
+
     types::string printSource() const override {
         const auto x = CODE_NAME_IN(ports, 0);
         const auto y = CODE_NAME_OUT(ports, 0);
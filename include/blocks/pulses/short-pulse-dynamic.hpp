@@ -27,11 +27,16 @@ public:
         time_start(0) {
         ports = new Ports<Type>(2, 1);
         register_ports(ports);
+        toggleFlag(TIMER);
+    }
+
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &ShortPulseDynamic::ports);
     }
 
     void compute() const override {
         // Если импульс активен
-        if (context.time < T_off) {
+        if (context->time < T_off) {
             if (*ports->inputs[0] != 0) {
                 ports->outputs[0] = 1.0;
             }
@@ -45,7 +50,7 @@ public:
             // Импульс не активен, проверяем фронт входного сигнала
             if (!prev_x && *ports->inputs[0] != 0) {
                 ports->outputs[0] = 1.0;
-                time_start        = context.time;
+                time_start        = context->time;
                 T_off             = time_start + static_cast<Time>(*ports->inputs[1] * Context::sec);
             }
             else {
@@ -55,21 +60,28 @@ public:
         }
 
         // Обработка изменения T во время активного импульса (если входной сигнал не равен 0)
-        if (prev_T != *ports->inputs[1] && context.time < T_off && *ports->inputs[0] != 0) {
-            Time elapsed   = context.time - time_start;
+        if (prev_T != *ports->inputs[1] && context->time < T_off && *ports->inputs[0] != 0) {
+            Time elapsed   = context->time - time_start;
             Time new_total = static_cast<Time>(*ports->inputs[1] * Context::sec);
 
             if (elapsed < new_total) {
                 T_off = time_start + new_total;
             }
             else {
-                T_off = context.time;
+                T_off = context->time;
             }
         }
 
         prev_T = *ports->inputs[1];
     }
 
+    types::time deadline() const override {
+        // Импульс, завершённый уменьшением T, снимается на следующем шаге (как в compute())
+        if (ports->outputs[0] != 0 && T_off <= context->time)
+            return context->time + context->dt;
+        return upcoming({T_off});
+    }
+
     std::string printMemory() const override {
         const auto type = CODE_NAME_TYPE(Time);
         const auto min  = CODE_NAME_MIN(Time);
@@ -86,6 +98,10 @@ public:
         return line.str();
     }
 
+    void visitState(const StateVisitor& visit) const override {
+        visit_state(visit, prev_x, T_off, time_start, prev_T);
+    }
+
     types::string printSource() const override {
         const auto x       = CODE_NAME_IN(ports, 0);
         const auto T_param = CODE_NAME_IN(ports, 1);
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "constants/config.hxx"
+
+#include "block.h"
+#include "ports.hpp"
+
+#include <sstream>
+
+namespace nrcki {
+/// Преобразование типа сигнала (вещественный <-> логический): вставляется схемой на связях портов разных типов
+template <typename From, typename To>
+class Cast final : public Block {
+    Ports<From>* in;
+    Ports<To>* out;
+
+public:
+    explicit Cast(const Context& context) :
+        Block(context) {
+        register_ports(1, 1, in, out);
+        toggleFlag(EVENT_DRIVEN);
+    }
+
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &Cast::in, &Cast::out);
+    }
+
+    void compute() const override {
+        out->outputs[0] = static_cast<To>(*in->inputs[0]);
+    }
+
+    types::string printSource() const override {
+        const auto x = CODE_NAME_IN(in, 0);
+        const auto y = CODE_NAME_OUT(out, 0);
+
+        std::stringstream line;
+        line << y << " = static_cast<" << CODE_NAME_TYPE(To) << ">(" << x << ");";
+        return line.str();
+    }
+
+    bool tryMakeConstant() override {
+        if (context->ports_info[in->inputs[0]].is_constant) {
+            context->ports_info[&out->outputs[0]].is_constant = true;
+            toggleFlag(Block::FlagType::CONSTANT);
+            return true;
+        }
+        return false;
+    }
+};
+}
\ No newline at end of file
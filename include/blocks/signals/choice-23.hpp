@@ -46,6 +46,10 @@ public:
         register_ports(ports);
     }
 
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &Choice23::ports);
+    }
+
     void compute() const override {
         // Получаем входные сигналы
         bool I[3] = {
@@ -104,7 +108,7 @@ public:
         // 4. Обновление таймеров рассогласования для каждого канала
         for (int i = 0; i < 3; ++i) {
             if (discordance_now[i]) {
-                channels[i].discordance_timer += Context::dt;
+                channels[i].discordance_timer += step();
                 channels[i].clear_timer       = 0;
 
                 // Если таймер превысил TV, фиксируем рассогласование
@@ -113,7 +117,7 @@ public:
                 }
             }
             else {
-                channels[i].clear_timer += Context::dt;
+                channels[i].clear_timer += step();
 
                 // Если рассогласование было обнаружено, но его нет сейчас
                 if (channels[i].discordance_detected) {
@@ -174,7 +178,7 @@ public:
         }
         else {
             // Уже переключены на EW - обновляем таймер
-            switch_timer += Context::dt;
+            switch_timer += step();
         }
 
         // 7. Обработка квитирования (QUIT)
@@ -211,6 +215,10 @@ public:
         ports->outputs[5] = switched_to_ew ? 1.0 : 0.0;
     }
 
+    void visitState(const StateVisitor& visit) const override {
+        visit_state(visit, channels, switched_to_ew, switch_timer, awaiting_second_change);
+    }
+
     types::string printSource() const override {
         const auto x1 = CODE_NAME_IN(ports, 0);
         const auto x2 = CODE_NAME_IN(ports, 1);
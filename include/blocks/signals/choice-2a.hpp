@@ -49,11 +49,18 @@ class Choice2A final : public Block {
         return MIMA != 0 ? MAX : MIN;
     }
 
+    // Коэффициенты сглаживания разности и выхода (пересчитываются при изменении шага)
+    Type alpha_ZAB = 1, alpha_ZSFU = 1;
+
+    // Коэффициент инерционного звена первого порядка: dt / (T + dt), 1 - без сглаживания
+    Type smoothing(Type time_constant) const {
+        return time_constant > 0 ? step_sec() / (time_constant + step_sec()) : 1;
+    }
+
     // Функция сглаживания (инерционное звено первого порядка)
-    Type smooth(Type current, Type prev, Type time_constant, Type dt) const {
-        if (time_constant <= 0)
+    static Type smooth(Type current, Type prev, Type alpha) {
+        if (alpha >= 1)
             return current;
-        Type alpha = dt / (time_constant + dt);
         return prev + alpha * (current - prev);
     }
 
@@ -68,6 +75,16 @@ public:
         prev_Y(0), prev_diff(0), timer1(0), timer2(0), initialized(false) {
         ports = new Ports<Type>(4, 7);
         register_ports(ports);
+        discretize();
+    }
+
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &Choice2A::ports);
+    }
+
+    void discretize() override {
+        alpha_ZAB  = smoothing(VZAB);
+        alpha_ZSFU = smoothing(VZSFU);
     }
 
     void compute() const override {
@@ -83,12 +100,12 @@ public:
 
         // Таймеры для недостоверных сигналов
         if (!fg1_ok)
-            timer1 += Context::dt;
+            timer1 += step();
         else
             timer1 = 0;
 
         if (!fg2_ok)
-            timer2 += Context::dt;
+            timer2 += step();
         else
             timer2 = 0;
 
@@ -140,7 +157,7 @@ public:
             Type jump = std::abs(raw_value - prev_Y);
             if (jump > GWSFU) {
                 // Применяем инерционное звено только если скачок превышает предел
-                output_Y = smooth(raw_value, prev_Y, VZSFU, Context::dt_sec);
+                output_Y = smooth(raw_value, prev_Y, alpha_ZSFU);
             }
         }
 
@@ -149,7 +166,7 @@ public:
 
         // Формирование сигнала отклонения ABW
         Type diff          = std::abs(X2 - X1);
-        Type smoothed_diff = smooth(diff, prev_diff, VZAB, Context::dt_sec);
+        Type smoothed_diff = smooth(diff, prev_diff, alpha_ZAB);
         prev_diff          = smoothed_diff;
 
         if (SAB == 0) {
@@ -192,6 +209,10 @@ public:
         }
     }
 
+    void visitState(const StateVisitor& visit) const override {
+        visit_state(visit, prev_Y, prev_diff, timer1, timer2, initialized);
+    }
+
     types::string printSource() const override {
         const auto x1 = CODE_NAME_IN(ports, 0);
         const auto x2 = CODE_NAME_IN(ports, 1);
@@ -20,6 +20,10 @@ public:
         register_ports(ports);
     }
 
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &Choice4D::ports);
+    }
+
     void compute() const override {
         int count =
             (*ports->inputs[0] != 0) +
@@ -59,6 +59,10 @@ public:
         register_ports(ports);
     }
 
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &ChoiceMedian3A::ports);
+    }
+
     void compute() const override {
         // Получаем входные сигналы
         Type X1 = *ports->inputs[0];
@@ -112,7 +116,7 @@ public:
 
         // Обновление таймеров для каждого канала
         if (exceed1 && FG1 != 0) {
-            timer1 += Context::dt;
+            timer1 += step();
         }
         else {
             timer1     = 0;
@@ -120,7 +124,7 @@ public:
         }
 
         if (exceed2 && FG2 != 0) {
-            timer2 += Context::dt;
+            timer2 += step();
         }
         else {
             timer2     = 0;
@@ -128,7 +132,7 @@ public:
         }
 
         if (exceed3 && FG3 != 0) {
-            timer3 += Context::dt;
+            timer3 += step();
         }
         else {
             timer3     = 0;
@@ -199,6 +203,10 @@ public:
         ports->outputs[3] = ST3_val ? 1.0 : 0.0; // ST3
     }
 
+    void visitState(const StateVisitor& visit) const override {
+        visit_state(visit, timer1, timer2, timer3, st1_active, st2_active, st3_active, last_Y);
+    }
+
     types::string printSource() const override {
         const auto x1 = CODE_NAME_IN(ports, 0);
         const auto x2 = CODE_NAME_IN(ports, 1);
@@ -4,7 +4,9 @@
 
 #include "block.h"
 #include "ports.hpp"
+#include "tape.hpp"
 
+#include <cmath>
 #include <sstream>
 
 namespace nrcki {
@@ -23,6 +25,12 @@ public:
         register_signals(signals = new Signals<Type>(1, 0));
     }
 
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        auto copy = clone_as(context, &ExtInSignal::ports);
+        static_cast<ExtInSignal&>(*copy).signals = static_cast<Signals<Type>*>(copy->getSignals());
+        return copy;
+    }
+
     void init() const override {
         ports->outputs[0] = y0;
     }
@@ -31,6 +39,14 @@ public:
         ports->outputs[0] = signals->inputs[0];
     }
 
+    bool isSteady(const types::real tolerance) const override {
+        return std::abs(signals->inputs[0] - ports->outputs[0]) <= tolerance;
+    }
+
+    bool lower(Tape& tape) const override {
+        return tape.emitInput(this, ports, signals->getInputOffset());
+    }
+
     types::string printInit() const override {
         const auto y = CODE_NAME_OUT(ports, 0);
 
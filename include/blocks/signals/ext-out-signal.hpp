@@ -4,7 +4,9 @@
 
 #include "block.h"
 #include "ports.hpp"
+#include "tape.hpp"
 
+#include <cmath>
 #include <sstream>
 
 namespace nrcki {
@@ -21,10 +23,24 @@ public:
         register_signals(signals = new Signals<Type>(0, 1));
     }
 
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        auto copy = clone_as(context, &ExtOutSignal::ports);
+        static_cast<ExtOutSignal&>(*copy).signals = static_cast<Signals<Type>*>(copy->getSignals());
+        return copy;
+    }
+
     void compute() const override {
         ports->outputs[0] = *ports->inputs[0];
     }
 
+    bool isSteady(const types::real tolerance) const override {
+        return std::abs(*ports->inputs[0] - ports->outputs[0]) <= tolerance;
+    }
+
+    bool lower(Tape& tape) const override {
+        return tape.emit(Tape::Op::Copy, this, ports);
+    }
+
     types::string printInit() const override {
         const auto x = CODE_NAME_IN(ports, 0);
         const auto y = CODE_NAME_OUT(ports, 0);
@@ -5,6 +5,7 @@
 #include "block.h"
 #include "ports.hpp"
 
+#include <cmath>
 #include <sstream>
 
 namespace nrcki {
@@ -25,8 +26,12 @@ public:
         register_ports(ports);
     }
 
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &IntInSignal::ports);
+    }
+
     void init() const override {
-        in                = static_cast<Type*>(context.blocks[out_block]->getOutputPortAbsolute(0));
+        in                = static_cast<Type*>(context->blocks[out_block]->getOutputPortAbsolute(0));
         ports->outputs[0] = y0;
     }
 
@@ -34,6 +39,15 @@ public:
         ports->outputs[0] = *in;
     }
 
+    bool isSteady(const types::real tolerance) const override {
+        return std::abs(*in - ports->outputs[0]) <= tolerance;
+    }
+
+    void visitImplicitInputs(const std::function<void*(void*)>& visit) const override {
+        if (in)
+            in = static_cast<Type*>(visit(in));
+    }
+
     types::string printInit() const override {
         const auto y = CODE_NAME_OUT(ports, 0);
 
@@ -44,7 +58,7 @@ public:
 
     types::string printSource() const override {
         const auto x = types::type_codename(ports->getTypeHash()) + '[' + std::to_string(
-                           context.ports_info.at(in).relative_index) + ']';
+                           context->ports_info.at(in).relative_index) + ']';
         const auto y = CODE_NAME_OUT(ports, 0);
 
         std::stringstream line;
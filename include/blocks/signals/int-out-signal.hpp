@@ -18,6 +18,11 @@ public:
         Block(context) {
         ports = new Ports<Type>(1, 1);
         register_ports(ports);
+        toggleFlag(EVENT_DRIVEN);
+    }
+
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &IntOutSignal::ports);
     }
 
     void compute() const override {
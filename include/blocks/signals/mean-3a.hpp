@@ -33,11 +33,18 @@ class Mean3A final : public Block {
     mutable Type prev_diff31; // Предыдущее значение разности X3-X1
     mutable bool initialized; // Флаг инициализации
 
+    // Коэффициенты сглаживания разности и выходного сигнала (пересчитываются при изменении шага)
+    Type alpha_ZAB = 1, alpha_ZSFU = 1;
+
+    // Коэффициент инерционного звена первого порядка: dt / (T + dt), 1 - без сглаживания
+    Type smoothing(Type time_constant) const {
+        return time_constant > 0 ? step_sec() / (time_constant + step_sec()) : 1;
+    }
+
     // Функция сглаживания (инерционное звено первого порядка)
-    Type smooth(Type current, Type prev, Type time_constant) const {
-        if (time_constant <= 0)
+    static Type smooth(Type current, Type prev, Type alpha) {
+        if (alpha >= 1)
             return current;
-        Type alpha = Context::dt_sec / (time_constant + Context::dt_sec);
         return prev + alpha * (current - prev);
     }
 
@@ -60,6 +67,16 @@ public:
         prev_Y(0), prev_diff12(0), prev_diff23(0), prev_diff31(0), initialized(false) {
         ports = new Ports<Type>(6, 8); // 6 входов, 8 выходов
         register_ports(ports);
+        discretize();
+    }
+
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &Mean3A::ports);
+    }
+
+    void discretize() override {
+        alpha_ZAB  = smoothing(VZAB);
+        alpha_ZSFU = smoothing(VZSFU);
     }
 
     void compute() const override {
@@ -85,9 +102,9 @@ public:
 
         if (SVZAB == 0) {
             // Сглаживание разрешено
-            diff12 = smooth(diff12, prev_diff12, VZAB);
-            diff23 = smooth(diff23, prev_diff23, VZAB);
-            diff31 = smooth(diff31, prev_diff31, VZAB);
+            diff12 = smooth(diff12, prev_diff12, alpha_ZAB);
+            diff23 = smooth(diff23, prev_diff23, alpha_ZAB);
+            diff31 = smooth(diff31, prev_diff31, alpha_ZAB);
         }
 
         prev_diff12 = diff12;
@@ -161,7 +178,7 @@ public:
             Type jump = std::abs(raw_value - prev_Y);
             if (jump > GWSFU) {
                 // Применяем инерционное звено только если скачок превышает предел
-                output_Y = smooth(raw_value, prev_Y, VZSFU);
+                output_Y = smooth(raw_value, prev_Y, alpha_ZSFU);
             }
         }
 
@@ -178,6 +195,10 @@ public:
         ports->outputs[7] = (valid_count >= 2) ? 1.0 : 0.0; // FG
     }
 
+    void visitState(const StateVisitor& visit) const override {
+        visit_state(visit, prev_Y, prev_diff12, prev_diff23, prev_diff31, initialized);
+    }
+
     types::string printSource() const override {
         const auto x1 = CODE_NAME_IN(ports, 0);
         const auto x2 = CODE_NAME_IN(ports, 1);
@@ -37,12 +37,14 @@ class Mean4A final : public Block {
         {0, 1}, {0, 2}, {0, 3}, {1, 2}, {1, 3}, {2, 3}
     };
 
+    // Коэффициент сглаживания разностей: dt / (VZ + dt), 1 - без сглаживания (пересчитывается при изменении шага)
+    Type alpha_Z = 1;
+
     // Функция сглаживания
-    Type smooth(Type current, Type prev, Type time_constant) const {
-        if (time_constant <= 0 || SVZ != 0)
+    Type smooth(Type current, Type prev) const {
+        if (alpha_Z >= 1 || SVZ != 0)
             return current;
-        Type alpha = Context::dt_sec / (time_constant + Context::dt_sec);
-        return prev + alpha * (current - prev);
+        return prev + alpha_Z * (current - prev);
     }
 
     // Проверка на отклонение
@@ -72,6 +74,15 @@ public:
         prev_diffs(6, 0), initialized(false) {
         ports = new Ports<Type>(8, 10); // 8 входов, 10 выходов
         register_ports(ports);
+        discretize();
+    }
+
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &Mean4A::ports);
+    }
+
+    void discretize() override {
+        alpha_Z = VZ > 0 ? step_sec() / (VZ + step_sec()) : 1;
     }
 
     void compute() const override {
@@ -108,7 +119,7 @@ public:
                 int i              = diff_pairs[k].i;
                 int j              = diff_pairs[k].j;
                 Type diff          = std::abs(X[i] - X[j]);
-                Type smoothed_diff = smooth(diff, prev_diffs[k], VZ);
+                Type smoothed_diff = smooth(diff, prev_diffs[k]);
                 prev_diffs[k]      = smoothed_diff;
                 exceed_flags[k]    = isDeviation(smoothed_diff);
             }
@@ -233,6 +244,10 @@ public:
         ports->outputs[9] = (final_valid_count >= 2) ? 1.0 : 0.0; // FG
     }
 
+    void visitState(const StateVisitor& visit) const override {
+        visit_state(visit, prev_diffs, initialized);
+    }
+
     types::string printSource() const override {
         const auto x1 = CODE_NAME_IN(ports, 0);
         const auto x2 = CODE_NAME_IN(ports, 1);
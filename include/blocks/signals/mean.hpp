@@ -34,6 +34,10 @@ public:
         register_ports(ports);
     }
 
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &Mean::ports);
+    }
+
     void compute() const override {
         // Получаем входные сигналы
         Type X1 = *ports->inputs[0];
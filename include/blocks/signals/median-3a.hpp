@@ -37,6 +37,10 @@ public:
         register_ports(ports);
     }
 
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &Median3A::ports);
+    }
+
     void compute() const override {
         // Получаем входные сигналы
         Type X1  = *ports->inputs[0];
@@ -21,6 +21,10 @@ public:
         register_ports(ports);
     }
 
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &Min4::ports);
+    }
+
     void compute() const override {
         ports->outputs[0] = std::min({
             *ports->inputs[4] != 0 ? *ports->inputs[0] : +9'999'999,
@@ -28,6 +28,8 @@ class NonlinearFilter final : public Block {
     mutable Type integral;    // Значение интегратора
     mutable bool initialized; // Флаг инициализации
 
+    Type dt_T = 0, inv_A = 0; // Дискретные коэффициенты: dt / T, 1 / A
+
 public:
     explicit NonlinearFilter(const Context& context,
                              Type A = 0, Type K1 = 1, Type K2 = 0.5,
@@ -41,6 +43,16 @@ public:
         prev_D(0), prev_Y(0), integral(0), initialized(false) {
         ports = new Ports<Type>(1, 1); // 1 вход, 1 выход
         register_ports(ports);
+        discretize();
+    }
+
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &NonlinearFilter::ports);
+    }
+
+    void discretize() override {
+        dt_T  = step_sec() / T;
+        inv_A = 1 / A;
     }
 
     void compute() const override {
@@ -85,22 +97,9 @@ public:
         // 4. Суммирование выходов LG и NLG
         Type sum_LG_NLG = LG_out + NLG_out;
 
-        // 5. Определение переменной постоянной времени интегратора
-        // Постоянная времени зависит от разностного сигнала D и параметра A
-        Type T_int = 0;
-        if (A > 0) {
-            // T_int = T * (1 + |D| / A)
-            T_int = T * (1.0 + abs_D / A);
-        }
-        else {
-            T_int = T;
-        }
-
-        // 6. Интегрирование с переменной постоянной времени
-        // Интегратор: Y = ∫(sum_LG_NLG / T_int) dt
-        if (T_int > 0) {
-            integral += (sum_LG_NLG / T_int) * Context::dt_sec;
-        }
+        // 5-6. Интегрирование с переменной постоянной времени T_int = T * (1 + |D| / A)
+        // Интегратор: Y = ∫(sum_LG_NLG / T_int) dt, A > 0 и T > 0 гарантируются конструктором
+        integral += sum_LG_NLG * dt_T / (1.0 + abs_D * inv_A);
 
         // 7. Формирование выходного сигнала
         Type Y = integral;
@@ -122,6 +121,10 @@ public:
         ports->outputs[0] = Y;
     }
 
+    void visitState(const StateVisitor& visit) const override {
+        visit_state(visit, prev_D, prev_Y, integral, initialized);
+    }
+
     types::string printSource() const override {
         const auto x1 = CODE_NAME_IN(ports, 0);
         const auto x2 = CODE_NAME_IN(ports, 1);
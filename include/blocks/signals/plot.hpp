@@ -19,5 +19,9 @@ public:
 
         toggleFlag(Block::FlagType::CONSTANT);
     }
+
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &Plot::ports);
+    }
 };
 }
\ No newline at end of file
@@ -7,7 +7,7 @@
 
 #include <cmath>
 #include <sstream>
-#include <queue>
+#include <deque>
 
 namespace nrcki {
 class ReplaceInvalidSignal final : public Block {
@@ -17,7 +17,7 @@ class ReplaceInvalidSignal final : public Block {
     Ports<Type>* ports;
     const Type TW1;
 
-    mutable std::queue<Type> delay_buffer; // Буфер задержки на 3 цикла
+    mutable std::deque<Type> delay_buffer; // Буфер задержки на 3 цикла
     mutable Time timer_start;              // Время начала задержки TW1
     mutable bool in_transition;            // Флаг перехода на нормальный режим
     mutable Type prev_KFGV;                // Предыдущее значение KFGV
@@ -35,10 +35,14 @@ public:
         register_ports(ports);
 
         for (int i = 0; i < 3; ++i) {
-            delay_buffer.push(0);
+            delay_buffer.push_back(0);
         }
     }
 
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &ReplaceInvalidSignal::ports);
+    }
+
     void compute() const override {
         Type ERSW = *ports->inputs[0]; // Замещающее значение
         Type X    = *ports->inputs[1]; // Входной сигнал
@@ -46,9 +50,9 @@ public:
         Type KFGR = *ports->inputs[3]; // Принудительная недостоверность
 
         // Обновление буфера задержки
-        delay_buffer.push(X);
+        delay_buffer.push_back(X);
         if (delay_buffer.size() > 3) {
-            delay_buffer.pop();
+            delay_buffer.pop_front();
         }
         Type delayed_X = delay_buffer.front(); // Сигнал X, задержанный на 3 цикла
 
@@ -59,11 +63,11 @@ public:
                 // Нет принудительной недостоверности
                 if (!in_transition) {
                     // Начало перехода на нормальный режим
-                    timer_start   = context.time;
+                    timer_start   = context->time;
                     in_transition = true;
                 }
 
-                if (context.time >= timer_start + TW1) {
+                if (context->time >= timer_start + TW1) {
                     // Переход завершен - нормальный режим
                     ports->outputs[0] = delayed_X; // Y = X задержанный на 3 цикла
                     ports->outputs[1] = 1;         // KFGV = 1 (достоверно)
@@ -100,6 +104,12 @@ public:
         prev_Y = ports->outputs[0];
     }
 
+    void visitState(const StateVisitor& visit) const override {
+        for (auto& value : delay_buffer)
+            visit(&value, sizeof value);
+        visit_state(visit, timer_start, in_transition, prev_KFGV, prev_Y);
+    }
+
     types::string printMemory() const override {
         const auto time_type = CODE_NAME_TYPE(Time);
         const auto type      = CODE_NAME_TYPE(Type);
@@ -23,6 +23,10 @@ public:
         register_ports(ports);
     }
 
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &ThresholdHysteresis::ports);
+    }
+
     void init() const override {
         ports->outputs[0] = 0;
         compute();
@@ -8,8 +8,8 @@
 #include <sstream>
 
 namespace nrcki {
+template <typename Type = types::real>
 class Constant final : public Block {
-    using Type = types::real;
 
     Ports<Type>* ports;
     const Type value;
@@ -24,9 +24,13 @@ public:
         toggleFlag(Block::FlagType::CONSTANT);
     }
 
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &Constant::ports);
+    }
+
     void init() const override {
         ports->outputs[0]                                  = value;
-        context.ports_info[&ports->outputs[0]].is_constant = true;
+        context->ports_info[&ports->outputs[0]].is_constant = true;
     }
 
     types::string printInit() const override {
@@ -3,13 +3,16 @@
 #include "constants/config.hxx"
 
 #include "block.h"
+#include "kernels.hpp"
 #include "ports.hpp"
+#include "tape.hpp"
 
+#include <cmath>
 #include <sstream>
 
 namespace nrcki {
+template <typename Type = types::real>
 class LinearSource final : public Block {
-    using Type = types::real;
 
     Ports<Type>* ports;
     const Type k, b;
@@ -22,8 +25,20 @@ public:
         register_ports(ports);
     }
 
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &LinearSource::ports);
+    }
+
     void compute() const override {
-        ports->outputs[0] = b + k * static_cast<Type>(context.time) / Context::sec;
+        ports->outputs[0] = kernels::linearSource(k, b, static_cast<types::real>(context->time));
+    }
+
+    bool isSteady(const types::real tolerance) const override {
+        return std::abs(k * step_sec()) <= tolerance;
+    }
+
+    bool lower(Tape& tape) const override {
+        return tape.emit(Tape::Op::LinearSource, this, ports, {k, b});
     }
 
     types::string printSource() const override {
@@ -3,14 +3,16 @@
 #include "constants/config.hxx"
 
 #include "block.h"
+#include "kernels.hpp"
 #include "ports.hpp"
+#include "tape.hpp"
 
 #include <sstream>
 #include <cmath>
 
 namespace nrcki {
+template <typename Type = types::real>
 class SinusSource final : public Block {
-    using Type = types::real;
 
     Ports<Type>* ports;
     const Type a, w, f; /// амплитуда, частота, фаза
@@ -23,8 +25,20 @@ public:
         register_ports(ports);
     }
 
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &SinusSource::ports);
+    }
+
     void compute() const override {
-        ports->outputs[0] = a * std::sin(w * static_cast<Type>(context.time) / Context::sec + f);
+        ports->outputs[0] = kernels::sinusSource(a, w, f, static_cast<types::real>(context->time));
+    }
+
+    bool isSteady(const types::real tolerance) const override {
+        return std::abs(a) <= tolerance || w == 0;
+    }
+
+    bool lower(Tape& tape) const override {
+        return tape.emit(Tape::Op::SinusSource, this, ports, {a, w, f});
     }
 
     types::string printSource() const override {
@@ -3,13 +3,15 @@
 #include "constants/config.hxx"
 
 #include "block.h"
+#include "kernels.hpp"
 #include "ports.hpp"
+#include "tape.hpp"
 
 #include <sstream>
 
 namespace nrcki {
+template <typename Type = types::real>
 class Step final : public Block {
-    using Type = types::real;
     using Time = types::time;
 
     Ports<Type>* ports;
@@ -23,10 +25,23 @@ public:
         value(value), y0(y0) {
         ports = new Ports<Type>(0, 1);
         register_ports(ports);
+        toggleFlag(TIMER);
+    }
+
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &Step::ports);
     }
 
     void compute() const override {
-        ports->outputs[0] = context.time < time ? y0 : value;
+        ports->outputs[0] = kernels::step(context->time, time, y0, value);
+    }
+
+    types::time deadline() const override {
+        return upcoming({time});
+    }
+
+    bool lower(Tape& tape) const override {
+        return tape.emit(Tape::Op::Step, this, ports, {static_cast<Type>(time), value, y0});
     }
 
     types::string printSource() const override {
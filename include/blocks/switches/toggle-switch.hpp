@@ -3,13 +3,15 @@
 #include "constants/config.hxx"
 
 #include "block.h"
+#include "kernels.hpp"
 #include "ports.hpp"
+#include "tape.hpp"
 
 #include <sstream>
 
 namespace nrcki {
+template <typename Type = types::real>
 class ToggleSwitch final : public Block {
-    using Type = types::real;
 
     Ports<Type>* ports;
 
@@ -18,10 +20,19 @@ public:
         Block(context) {
         ports = new Ports<Type>(3, 1);
         register_ports(ports);
+        toggleFlag(EVENT_DRIVEN);
+    }
+
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &ToggleSwitch::ports);
     }
 
     void compute() const override {
-        ports->outputs[0] = *ports->inputs[2] != 0 ? *ports->inputs[1] : *ports->inputs[0];
+        ports->outputs[0] = kernels::toggleSwitch(*ports->inputs[0], *ports->inputs[1], *ports->inputs[2]);
+    }
+
+    bool lower(Tape& tape) const override {
+        return tape.emit(Tape::Op::ToggleSwitch, this, ports);
     }
 
     types::string printSource() const override {
@@ -4,22 +4,29 @@
 
 #include "block.h"
 #include "ports.hpp"
+#include "tape.hpp"
 
 #include <sstream>
 
 namespace nrcki {
+template <typename Logic = types::real>
 class SrTrigger final : public Block {
     using Type = types::real;
 
-    Ports<Type>* ports;
+    Ports<Logic>* ports;
     const Type y0;
 
 public:
     explicit SrTrigger(const Context& context, const Type& y0) :
         Block(context),
         y0(y0) {
-        ports = new Ports<Type>(2, 1);
+        ports = new Ports<Logic>(2, 1);
         register_ports(ports);
+        toggleFlag(EVENT_DRIVEN);
+    }
+
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &SrTrigger::ports);
     }
 
     void init() const override {
@@ -34,6 +41,10 @@ public:
             ports->outputs[0] = false;
     }
 
+    bool lower(Tape& tape) const override {
+        return tape.emit(Tape::Op::SrTrigger, this, ports);
+    }
+
     std::string printInit() const override {
         const auto y = CODE_NAME_OUT(ports, 0);
         std::stringstream line;
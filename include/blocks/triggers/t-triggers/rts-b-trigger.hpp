@@ -8,10 +8,10 @@
 #include <sstream>
 
 namespace nrcki {
+template <typename Logic = types::real>
 class RtsBTrigger final : public Block {
-    using Type = types::real;
 
-    Ports<Type>* ports;
+    Ports<Logic>* ports;
 
     const bool y0;
     mutable bool prev_x = false;
@@ -20,10 +20,14 @@ public:
     explicit RtsBTrigger(const Context& context, const bool y0 = false) :
         Block(context),
         y0(y0) {
-        ports = new Ports<Type>(3, 1);
+        ports = new Ports<Logic>(3, 1);
         register_ports(ports);
     }
 
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &RtsBTrigger::ports);
+    }
+
     void init() const override {
         prev_x            = *ports->inputs[1] != 0;
         ports->outputs[0] = y0;
@@ -58,6 +62,10 @@ public:
         return line.str() + printSource();
     }
 
+    void visitState(const StateVisitor& visit) const override {
+        visit_state(visit, prev_x);
+    }
+
     types::string printSource() const override {
         const auto s = CODE_NAME_IN(ports, 0);
         const auto t = CODE_NAME_IN(ports, 1);
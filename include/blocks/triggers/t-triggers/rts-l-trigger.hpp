@@ -8,10 +8,10 @@
 #include <sstream>
 
 namespace nrcki {
+template <typename Logic = types::real>
 class RtsLTrigger final : public Block {
-    using Type = types::real;
 
-    Ports<Type>* ports;
+    Ports<Logic>* ports;
 
     const bool y0;
 
@@ -19,10 +19,14 @@ public:
     explicit RtsLTrigger(const Context& context, const bool y0 = false) :
         Block(context),
         y0(y0) {
-        ports = new Ports<Type>(3, 1);
+        ports = new Ports<Logic>(3, 1);
         register_ports(ports);
     }
 
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &RtsLTrigger::ports);
+    }
+
     void init() const override {
         ports->outputs[0] = y0;
         compute();
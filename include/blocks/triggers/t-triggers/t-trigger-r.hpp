@@ -8,10 +8,10 @@
 #include <sstream>
 
 namespace nrcki {
+template <typename Logic = types::real>
 class TTriggerR final : public Block {
-    using Type = types::real;
 
-    Ports<Type>* ports;
+    Ports<Logic>* ports;
 
     const bool y0;
     mutable bool prev_x = false;
@@ -20,10 +20,14 @@ public:
     explicit TTriggerR(const Context& context, bool y0 = false) :
         Block(context),
         y0(y0) {
-        ports = new Ports<Type>(1, 1);
+        ports = new Ports<Logic>(1, 1);
         register_ports(ports);
     }
 
+    std::unique_ptr<Block> clone(const Context& context) const override {
+        return clone_as(context, &TTriggerR::ports);
+    }
+
     void init() const override {
         prev_x            = *ports->inputs[0] != 0;
         ports->outputs[0] = y0;
@@ -54,6 +58,10 @@ public:
         return line.str() + printSource();
     }
 
+    void visitState(const StateVisitor& visit) const override {
+        visit_state(visit, prev_x);
+    }
+
     types::string printSource() const override {
         const auto t = CODE_NAME_IN(ports, 0);
         const auto y = CODE_NAME_OUT(ports, 0);
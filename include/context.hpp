@@ -1,8 +1,10 @@
 #pragma once
 
 #include "constants/config.hxx"
+#include "discretization.hpp"
 
 #include <memory>
+#include <stdexcept>
 #include <vector>
 
 namespace nrcki {
@@ -11,27 +13,126 @@ struct PortInfo {
     types::size block_index = 0, relative_index = 0;
 };
 
+/**
+ * Сведения о выходных портах схемы: плотная таблица по слотам памяти портов.
+ * Адрес порта переводится в слот по участку памяти его типа (участков - по числу типов),
+ * поэтому поиск не хеширует адреса, а таблица не хранит ключей.
+ */
+class PortsInfo {
+    using size = types::size;
+
+public:
+    /// Участок памяти портов типа
+    struct Section {
+        size type_hash   = 0;
+        const void* data = nullptr;
+        size count = 0, type_size = 0;
+        size first = 0; // Первая запись участка в таблице
+    };
+
+private:
+    std::vector<Section> sections;
+    std::vector<PortInfo> table;
+    PortInfo detached; // Сведения для адресов вне памяти портов (не подключённые и замороженные входы)
+
+public:
+    /// Привязка к памяти портов; сведения сохраняются, если число слотов каждого типа не изменилось
+    void bind(std::vector<Section> value) {
+        size total = 0;
+        bool same  = value.size() == sections.size();
+        for (size i = 0; i < value.size(); ++i) {
+            value[i].first = total;
+            total          += value[i].count;
+            same           = same && value[i].type_hash == sections[i].type_hash && value[i].count == sections[i].count;
+        }
+        sections = std::move(value);
+        if (!same)
+            table.assign(total, {});
+    }
+
+    void clear() {
+        sections.clear();
+        table.clear();
+    }
+
+    static constexpr size npos = static_cast<size>(-1);
+
+    /// Запись таблицы для адреса порта, npos - адрес вне памяти портов
+    [[nodiscard]] size indexOf(const void* port) const {
+        const auto* address = static_cast<const types::byte*>(port);
+        for (const auto& [type_hash, data, count, type_size, first] : sections) {
+            const auto* begin = static_cast<const types::byte*>(data);
+            if (address >= begin && address < begin + count * type_size)
+                return first + (address - begin) / type_size;
+        }
+        return npos;
+    }
+
+    PortInfo* find(const void* port) {
+        const auto index = indexOf(port);
+        return index != npos ? &table[index] : nullptr;
+    }
+
+    [[nodiscard]] const PortInfo* find(const void* port) const {
+        const auto index = indexOf(port);
+        return index != npos ? &table[index] : nullptr;
+    }
+
+    [[nodiscard]] bool contains(const void* port) const {
+        return find(port) != nullptr;
+    }
+
+    // Как у std::unordered_map: для адреса вне памяти портов - сведения по умолчанию
+    PortInfo& operator[](const void* port) {
+        if (auto* info = find(port))
+            return *info;
+        return detached = {};
+    }
+
+    [[nodiscard]] const PortInfo& at(const void* port) const {
+        if (const auto* info = find(port))
+            return *info;
+        throw std::out_of_range("PortsInfo: port is outside of port memory");
+    }
+
+    /// Перестановка сведений участка типа вслед за значениями портов: slot -> remap[slot]
+    void permute(const size type_hash, const std::vector<size>& remap) {
+        for (const auto& section : sections)
+            if (section.type_hash == type_hash) {
+                const std::vector old(table.begin() + section.first, table.begin() + section.first + section.count);
+                for (size slot = 0; slot < section.count; ++slot)
+                    table[section.first + remap[slot]] = old[slot];
+            }
+    }
+};
+
 class Block;
 
 class Context {
     using Type      = types::real;
     using size      = types::size;
     using string    = types::string;
-    using PortsInfo = std::unordered_map<void*, PortInfo>;
     using BlocksVec = std::vector<std::unique_ptr<Block>>;
 
 public:
-    static constexpr Type dt_sec     = 1e-1;         // Шаг интегрирования [сек]
-    static constexpr types::time sec = 1e6;          // Основание времени [микро-секунды (мкс)]
-    static constexpr types::time dt  = sec * dt_sec; // Шаг интегрирования [мкс]
+    static constexpr types::time sec    = 1e6;  // Основание времени [микро-секунды (мкс)]
+    static constexpr Type default_dt_sec = 1e-1; // Шаг интегрирования по умолчанию [сек]
 
     const types::time& time; // Абсолютное время расчёта схемы [мкс]
+    const types::time& dt;   // Шаг интегрирования [мкс]
+    const Type& dt_sec;      // Шаг интегрирования [сек]
+
+    const Discretization& discretization; // Метод дискретизации линейных динамических звеньев
 
     PortsInfo& ports_info;
     const BlocksVec& blocks;
 
-    explicit Context(const types::time& time, PortsInfo& ports_info, const BlocksVec& blocks) :
+    explicit Context(const types::time& time, const types::time& dt, const Type& dt_sec,
+                     const Discretization& discretization, PortsInfo& ports_info, const BlocksVec& blocks) :
         time(time),
+        dt(dt),
+        dt_sec(dt_sec),
+        discretization(discretization),
         ports_info(ports_info),
         blocks(blocks) {
     }
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "constants/config.hxx"
+
+#include <cstdint>
+
+namespace nrcki {
+/// Метод дискретизации линейных динамических звеньев (вход удерживается постоянным на шаге)
+enum class Discretization : uint8_t {
+    Euler,         // Явный метод Эйлера (точность и устойчивость только при dt << T)
+    ZeroOrderHold, // Точное решение (матричная экспонента): устойчиво при любом шаге
+    Tustin,        // Билинейное преобразование (метод трапеций): устойчиво при любом шаге
+};
+
+namespace discretization {
+using types::real;
+
+// Коэффициенты рассчитываются в типе V: real, либо Tangent - вместе с производными по параметрам звена (см. Sensitivity)
+
+/**
+ * Коэффициент звена 1-го порядка T * dy/dt + y = u в форме y += (u - y) * a.
+ * @param method метод дискретизации
+ * @param h шаг [сек]
+ * @param T постоянная времени [сек]
+ */
+template <typename V>
+V firstOrder(Discretization method, real h, const V& T);
+
+/// Дискретная модель 2-го порядка: x[n+1] = phi * x[n] + gamma * u[n]
+template <typename V = real>
+struct StateSpace2 {
+    V phi[2][2];
+    V gamma[2];
+};
+
+/**
+ * Дискретизация непрерывной модели 2-го порядка dx/dt = a * x + b * u.
+ * @param method метод дискретизации
+ * @param a матрица состояния (невырожденная)
+ * @param b матрица входа
+ * @param h шаг [сек]
+ */
+template <typename V>
+StateSpace2<V> secondOrder(Discretization method, const V (&a)[2][2], const V (&b)[2], real h);
+}
+}
\ No newline at end of file
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "constants/config.hxx"
+
+#include <cmath>
+#include <cstddef>
+
+namespace nrcki {
+/**
+ * Дуальное число прямого режима автоматического дифференцирования: значение и N частных производных
+ * (по выбранным параметрам). Арифметика переносит производные по правилам дифференцирования,
+ * поэтому ядра (kernels.hpp) рассчитывают производные выходов вместе со значениями за один проход.
+ * Сравнения - по значению: ветвь кусочной функции выбирается значением, производная берётся на ней.
+ */
+template <typename T, std::size_t N>
+struct Dual {
+    T value{};
+    T grad[N]{};
+
+    Dual() = default;
+
+    Dual(const T x) : value(x) {}
+
+    /// Переменная дифференцирования с номером index
+    static Dual variable(const T x, const std::size_t index) {
+        Dual result(x);
+        result.grad[index] = 1;
+        return result;
+    }
+
+    friend Dual operator-(const Dual& a) {
+        Dual result(-a.value);
+        for (std::size_t i = 0; i < N; ++i)
+            result.grad[i] = -a.grad[i];
+        return result;
+    }
+
+    friend Dual operator+(const Dual& a, const Dual& b) {
+        Dual result(a.value + b.value);
+        for (std::size_t i = 0; i < N; ++i)
+            result.grad[i] = a.grad[i] + b.grad[i];
+        return result;
+    }
+
+    friend Dual operator-(const Dual& a, const Dual& b) {
+        Dual result(a.value - b.value);
+        for (std::size_t i = 0; i < N; ++i)
+            result.grad[i] = a.grad[i] - b.grad[i];
+        return result;
+    }
+
+    friend Dual operator*(const Dual& a, const Dual& b) {
+        Dual result(a.value * b.value);
+        for (std::size_t i = 0; i < N; ++i)
+            result.grad[i] = a.grad[i] * b.value + a.value * b.grad[i];
+        return result;
+    }
+
+    friend Dual operator/(const Dual& a, const Dual& b) {
+        Dual result(a.value / b.value);
+        for (std::size_t i = 0; i < N; ++i)
+            result.grad[i] = (a.grad[i] * b.value - a.value * b.grad[i]) / (b.value * b.value);
+        return result;
+    }
+
+    Dual& operator+=(const Dual& other) { return *this = *this + other; }
+    Dual& operator-=(const Dual& other) { return *this = *this - other; }
+    Dual& operator*=(const Dual& other) { return *this = *this * other; }
+    Dual& operator/=(const Dual& other) { return *this = *this / other; }
+
+    friend T primal(const Dual& a) { return a.value; }
+
+    friend bool operator==(const Dual& a, const Dual& b) { return a.value == b.value; }
+    friend bool operator!=(const Dual& a, const Dual& b) { return a.value != b.value; }
+    friend bool operator<(const Dual& a, const Dual& b) { return a.value < b.value; }
+    friend bool operator<=(const Dual& a, const Dual& b) { return a.value <= b.value; }
+    friend bool operator>(const Dual& a, const Dual& b) { return a.value > b.value; }
+    friend bool operator>=(const Dual& a, const Dual& b) { return a.value >= b.value; }
+
+    /// Функция f со значением fx и производной dfx в точке a.value
+    friend Dual chain(const Dual& a, const T fx, const T dfx) {
+        Dual result(fx);
+        for (std::size_t i = 0; i < N; ++i)
+            result.grad[i] = dfx * a.grad[i];
+        return result;
+    }
+
+    friend Dual abs(const Dual& a) { return a.value < 0 ? -a : a; }
+    friend Dual sin(const Dual& a) { return chain(a, std::sin(a.value), std::cos(a.value)); }
+    friend Dual cos(const Dual& a) { return chain(a, std::cos(a.value), -std::sin(a.value)); }
+    friend Dual exp(const Dual& a) { return chain(a, std::exp(a.value), std::exp(a.value)); }
+    friend Dual expm1(const Dual& a) { return chain(a, std::expm1(a.value), std::exp(a.value)); }
+    friend Dual sinh(const Dual& a) { return chain(a, std::sinh(a.value), std::cosh(a.value)); }
+    friend Dual cosh(const Dual& a) { return chain(a, std::cosh(a.value), std::sinh(a.value)); }
+    friend Dual log(const Dual& a) { return chain(a, std::log(a.value), 1 / a.value); }
+
+    friend Dual sqrt(const Dual& a) {
+        const auto root = std::sqrt(a.value);
+        return chain(a, root, 1 / (2 * root));
+    }
+};
+
+/// Дуальное число анализа чувствительности (см. Sensitivity): значение и tangent_width производных
+inline constexpr std::size_t tangent_width = 4;
+using Tangent                              = Dual<types::real, tangent_width>;
+}
\ No newline at end of file
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "constants/config.hxx"
+#include "tape.hpp"
+
+#include <cstdint>
+#include <span>
+#include <string>
+
+namespace nrcki {
+/**
+ * Образ схемы: позиционно-независимое двоичное представление полностью построенной схемы
+ * (лента инструкций - виды блоков и порядок расчёта, слоты входов - связи, параметры, состояние и значения портов).
+ * Участки адресуются смещениями от начала образа и выровнены по строке кэша,
+ * поэтому образ рассчитывается прямо в отображённой памяти файла без разбора и выделения памяти под блоки.
+ * Строится Scheme::getImage() для схем, все блоки которых понижены в ленту.
+ */
+struct ImageHeader {
+    static constexpr char signature[8]  = {'N', 'R', 'C', 'K', 'I', 'I', 'M', 'G'};
+    static constexpr uint32_t version   = 1;
+    static constexpr uint32_t alignment = 64;
+
+    /// Участок образа: смещение от начала и число элементов
+    struct Section {
+        uint64_t offset = 0, count = 0;
+    };
+
+    char magic[8]{};
+    uint32_t format           = 0;
+    uint32_t instruction_size = 0; // sizeof(Tape::Instruction) и sizeof(real) собравшей образ библиотеки
+    uint32_t real_size        = 0;
+    uint32_t reserved         = 0;
+    uint64_t image_size       = 0;
+
+    int64_t time = 0, dt = 0;
+    uint64_t dt_count = 0;
+
+    Section code;     // Tape::Instruction (без адресов блоков)
+    Section operands; // Слоты входов инструкций
+    Section params;   // Встроенные параметры
+    Section state;    // Состояние
+    Section memory;   // Значения вещественных портов
+    Section inputs;   // Внешние входы
+    Section outputs;  // Абсолютный индекс выхода -> слот (-1, если порт не вещественный)
+};
+
+/**
+ * Расчёт схемы по образу. Файл отображается в память с копированием при записи:
+ * лента и параметры читаются из общих страниц, изменяются только страницы состояния и портов,
+ * файл образа не меняется. Образ в памяти вызывающего рассчитывается на месте.
+ */
+class SchemeImage {
+    using Type = types::real;
+    using size = types::size;
+    using byte = types::byte;
+    using slot = Tape::slot;
+
+    void* mapping     = nullptr; // Отображение файла (nullptr - образ в памяти вызывающего)
+    size mapping_size = 0;
+
+    std::span<const Tape::Instruction> code;
+    const slot* operands = nullptr;
+    const Type* params   = nullptr;
+    Type* state          = nullptr;
+    Type* memory         = nullptr;
+    std::span<Type> inputs;
+    std::span<const slot> outputs;
+
+    uint64_t dt_count = 0;
+    types::time time  = 0;
+    types::time dt    = 0;
+
+    void bind(byte* image, size bytes);
+    void unmap();
+
+public:
+    /// Отображение файла образа
+    explicit SchemeImage(const std::string& path);
+    /// Образ в памяти вызывающего (выровнен по ImageHeader::alignment, изменяется при расчёте)
+    explicit SchemeImage(std::span<byte> image);
+
+    SchemeImage(const SchemeImage&)            = delete;
+    SchemeImage& operator=(const SchemeImage&) = delete;
+    SchemeImage(SchemeImage&& other) noexcept;
+    SchemeImage& operator=(SchemeImage&& other) noexcept;
+    ~SchemeImage();
+
+    void compute(uint64_t steps = 1);
+
+    [[nodiscard]] uint64_t getSteps() const { return dt_count; }
+    [[nodiscard]] types::time getTime() const { return time; }
+
+    /// Абсолютная индексация вещественных выходных портов
+    [[nodiscard]] Type getOutput(size index) const;
+    void setInput(size index, Type value);
+};
+}
\ No newline at end of file
@@ -0,0 +1,197 @@
+#pragma once
+
+#include "constants/config.hxx"
+#include "context.hpp"
+
+#include <cmath>
+
+namespace nrcki {
+/**
+ * Арифметика блоков, обобщённая по типу значения V: double, float, пакет полос (pack.hpp)
+ * и дуальное число (dual.hpp). Block::compute() и лента (Tape::run) рассчитывают через одни и те же ядра,
+ * поэтому при V = types::real результат ленты побитово совпадает с виртуальным расчётом.
+ * Порядок вычислений в каждом ядре сохранён по исходному выражению блока.
+ * Ветвление выражено через select(): для пакета условие - маска полос, для скаляра и дуального числа - bool.
+ * Состояние передаётся ссылкой, новое значение выхода возвращается.
+ */
+namespace kernels {
+using std::abs;
+using std::sin;
+
+/// Значение без производных (для дуального числа - его значение, см. dual.hpp)
+template <typename V>
+const V& primal(const V& x) {
+    return x;
+}
+
+template <typename V>
+V select(const bool condition, const V& a, const V& b) {
+    return condition ? a : b;
+}
+
+/// y = c0·x0 + c1·x1 + ...; coeff(i), input(i) - доступ к коэффициенту и входу
+template <typename V, typename Coeff, typename Input>
+V summator(const types::size n, const Coeff& coeff, const Input& input) {
+    V y = coeff(0) * input(0);
+    for (types::size i = 1; i < n; ++i)
+        y += coeff(i) * input(i);
+    return y;
+}
+
+template <typename V, typename Input>
+V multiplier(const types::size n, const Input& input) {
+    V y = input(0);
+    for (types::size i = 1; i < n; ++i)
+        y *= input(i);
+    return y;
+}
+
+template <typename V>
+V divider(const V& x0, const V& x1, const V& value_if_div_null) {
+    return select(x1 != V(0), x0 / x1, value_if_div_null);
+}
+
+template <typename V>
+V absolute(const V& x) {
+    return abs(x);
+}
+
+template <typename V>
+V negate(const V& x) {
+    return -x;
+}
+
+template <typename V>
+V sign(const V& x) {
+    return select(V(0) < x, V(1), select(x < V(0), V(-1), V(0)));
+}
+
+template <typename V>
+V saturation(const V& x, const V& x1, const V& x2, const V& y1, const V& y2, const V& k, const V& b) {
+    return select(x < x1, y1, select(x > x2, y2, k * x + b));
+}
+
+template <typename V>
+V deadband(const V& x, const V& x1, const V& x2, const V& k) {
+    return select(x < x1, k * (x - x1), select(x > x2, k * (x - x2), V(0)));
+}
+
+/// y - текущий выход: внутри петли гистерезиса сохраняется
+template <typename V>
+V hysteresis(const V& x, const V& x1, const V& x2, const V& y1, const V& y2, const V& y) {
+    return select(x <= x1, y1, select(x >= x2, y2, y));
+}
+
+template <typename V>
+V lowThreshold(const V& x, const V& activation, const V& deactivation, const V& y) {
+    return select(x > deactivation, V(0), select(x < activation, V(1), y));
+}
+
+template <typename V>
+V highThreshold(const V& x, const V& activation, const V& deactivation, const V& y) {
+    return select(x < deactivation, V(0), select(x > activation, V(1), y));
+}
+
+template <typename V>
+V toggleSwitch(const V& x0, const V& x1, const V& control) {
+    return select(control != V(0), x1, x0);
+}
+
+/**
+ * Кусочно-линейная характеристика по узлам x(i), y(i) и коэффициентам участков k(i), b(i), i < n.
+ * extra - продолжение крайних участков за пределы узлов (иначе насыщение значениями y),
+ * binary - двоичный поиск участка (иначе последовательный).
+ * Участок выбирается ветвлением, поэтому V - скаляр или дуальное число (сравнения возвращают bool).
+ */
+template <typename V, typename X, typename Y, typename K, typename B>
+V piecewiseLinear(const V& in, const types::size n, const X& x, const Y& y, const K& k, const B& b,
+                  const bool extra, const bool binary) {
+    types::size i;
+    if (in <= x(0)) {
+        if (!extra)
+            return y(0);
+        i = 1;
+    }
+    else if (in >= x(n - 1)) {
+        if (!extra)
+            return y(n - 1);
+        i = n - 1;
+    }
+    else if (binary) {
+        // upper_bound по [1, n)
+        types::size lo = 1, hi = n;
+        while (lo < hi) {
+            const types::size mid = lo + (hi - lo) / 2;
+            if (in < x(mid))
+                hi = mid;
+            else
+                lo = mid + 1;
+        }
+        i = lo;
+    }
+    else {
+        i = 1;
+        if (extra)
+            while (i < n && in >= x(i))
+                ++i;
+        else
+            while (i < n && in > x(i))
+                ++i;
+    }
+
+    return i < n ? k(i) * in + b(i) : V(0);
+}
+
+template <typename V>
+V integrator(const V& y, const V& k_dt, const V& x) {
+    return y + k_dt * x;
+}
+
+template <typename V>
+V inertial(const V& y, const V& k, const V& a, const V& x) {
+    return y + (k * x - y) * a;
+}
+
+/// prev_x - вход предыдущего шага (обновляется)
+template <typename V>
+V inertialDifferential(const V& y, V& prev_x, const V& c_x, const V& c_y, const V& x) {
+    const V next = y + (c_x * (x - prev_x) - c_y * y);
+    prev_x       = x;
+    return next;
+}
+
+/// Дискретная модель второго порядка: [y, dy] = phi · [y, dy] + gamma · x; prev_y, dy - состояние
+template <typename V, typename C>
+V oscillatory(const V& y, V& dy, V& prev_y, const C& phi00, const C& phi01, const C& phi10, const C& phi11,
+              const C& gamma0, const C& gamma1, const V& x) {
+    prev_y       = y;
+    const V next = phi00 * prev_y + phi01 * dy + gamma0 * x;
+    dy           = phi10 * prev_y + phi11 * dy + gamma1 * x;
+    return next;
+}
+
+/// prev_x - вход предыдущего шага (обновляется)
+template <typename V>
+V stepDelay(V& prev_x, const V& x) {
+    const V y = prev_x;
+    prev_x    = x;
+    return y;
+}
+
+/// now, at - время в единицах Context (целое в блоке, вещественное в ленте)
+template <typename V, typename T>
+V step(const T& now, const T& at, const V& y0, const V& value) {
+    return select(now < at, y0, value);
+}
+
+template <typename V, typename T>
+V linearSource(const V& k, const V& b, const T& time) {
+    return b + k * time / Context::sec;
+}
+
+template <typename V, typename T>
+V sinusSource(const V& a, const V& w, const V& f, const T& time) {
+    return a * sin(w * time / Context::sec + f);
+}
+}
+}
\ No newline at end of file
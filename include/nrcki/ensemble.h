@@ -0,0 +1,110 @@
+#pragma once
+
+#include "constants/config.hxx"
+#include "worker-pool.hpp"
+
+#include "scheme.h"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace nrcki {
+/**
+ * Ансамблевый расчёт (Монте-Карло, перебор параметров) одной схемы на пуле потоков.
+ * Варианты различаются вещественными параметрами блоков в описании схемы (формат assign()):
+ * сетка значений (декартово произведение всех сеток) и случайные выборки из распределений.
+ * Схема строится один раз: потоки разбирают варианты по одному, каждый вариант рассчитывается на копии
+ * построенной схемы (Scheme::fork()), в которой заменены только блоки с варьируемыми параметрами.
+ * Записанные выходы агрегируются по вариантам: среднее, минимум, максимум и квантили.
+ */
+class Ensemble {
+    using Type = types::real; // Вещественный тип
+    using byte = types::byte; // Тип для байта (8 бит)
+    using size = types::size; // Тип для размеров, индексации
+
+public:
+    /// Закон распределения случайного параметра
+    enum class Law : uint8_t {
+        Uniform, // Равномерный на [a, b]
+        Normal,  // Нормальный: среднее a, СКО b
+    };
+
+    /// Статистика выхода по вариантам
+    struct Statistics {
+        Type mean = 0, min = 0, max = 0;
+        std::vector<Type> quantiles; // В порядке уровней setQuantiles()
+    };
+
+private:
+    struct Grid {
+        size block  = 0; // Индекс блока
+        size offset = 0; // Смещение значения в описании схемы
+        std::vector<Type> values;
+    };
+
+    struct Random {
+        size block  = 0; // Индекс блока
+        size offset = 0; // Смещение значения в описании схемы
+        Law law     = Law::Uniform;
+        Type a = 0, b = 0;
+    };
+
+    uint32_t count = 0;        // Количество блоков
+    std::vector<byte> data;    // Описание схемы (формат assign())
+    std::vector<size> offsets; // Смещения описаний блоков и связей, последнее - размер описания
+    std::unique_ptr<const Scheme> prototype; // Построенная схема (не рассчитывается)
+
+    std::vector<Grid> grid;
+    std::vector<Random> random;
+    size samples  = 1; // Число случайных выборок на узел сетки
+    uint64_t seed = 0;
+
+    std::vector<size> outputs;          // Записываемые выходы: абсолютные индексы вещественных портов
+    std::vector<Type> levels;           // Уровни квантилей
+    std::function<void(Scheme&)> setup; // Настройка экземпляра перед расчётом
+    std::unique_ptr<WorkerPool> pool;
+
+    size variants = 0, records = 0;
+    std::vector<Type> values;           // Вариант -> запись -> выход
+    std::vector<Statistics> statistics; // Запись -> выход
+
+    size parameter_offset(size block, size field) const;
+    void aggregate();
+
+public:
+    /**
+     * @param blocks_count количество блоков
+     * @param description описание схемы (блоки и связи, формат Scheme::assign())
+     * @param bytes размер описания: разбор не выходит за него
+     */
+    Ensemble(uint32_t blocks_count, const byte* description, size bytes);
+
+    void setThreads(size threads);
+
+    // Настройка каждого экземпляра после построения (шаг, дискретизация, входы, периоды); вызывается из разных потоков
+    void setSetup(std::function<void(Scheme&)> function) { setup = std::move(function); }
+
+    void setOutputs(std::vector<size> ports);
+    void setQuantiles(std::vector<Type> quantile_levels);
+
+    // Варьируемые параметры: field - смещение вещественного значения от начала описания блока block
+    void addGrid(size block, size field, std::vector<Type> grid_values);
+    void addRandom(size block, size field, Law law, Type a, Type b);
+    void setSamples(size samples_count, uint64_t random_seed = 0);
+
+    void run(uint64_t steps, uint64_t record_interval = 0);
+
+    [[nodiscard]] size getVariantCount() const { return variants; }
+    [[nodiscard]] size getRecordCount() const { return records; }
+    [[nodiscard]] std::vector<Type> getParameters(size variant) const;
+
+    [[nodiscard]] Type getValue(const size variant, const size record, const size output) const {
+        return values[(variant * records + record) * outputs.size() + output];
+    }
+
+    [[nodiscard]] const Statistics& getStatistics(const size record, const size output) const {
+        return statistics[record * outputs.size() + output];
+    }
+};
+}
\ No newline at end of file
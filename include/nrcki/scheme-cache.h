@@ -0,0 +1,76 @@
+#pragma once
+
+#include "constants/config.hxx"
+
+#include "scheme.h"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace nrcki {
+/**
+ * Кэш построенных схем по хешу содержимого описания (формат assign(): блоки и связи) и настроек построения.
+ * При первом обращении схема строится полностью (разбор, сортировка, свёртка констант, раскладка арены)
+ * и хранится как прототип, каждый экземпляр - независимая копия прототипа (Scheme::fork()) без повторного построения.
+ * Совпадение хеша проверяется побайтовым сравнением описаний.
+ * Каталог (setDirectory) хранит описания между запусками: load() строит прототипы всех сохранённых схем заранее.
+ */
+class SchemeCache {
+    using byte = types::byte; // Тип для байта (8 бит)
+    using size = types::size; // Тип для размеров, индексации
+
+public:
+    /// Настройки, задаваемые до assign() и влияющие на построение
+    struct Settings {
+        bool logic_ports    = false;
+        Precision precision = Precision::Double;
+    };
+
+private:
+    struct Entry {
+        uint32_t count = 0;
+        Settings settings;
+        std::vector<byte> data;                 // Описание схемы
+        std::shared_ptr<const Scheme> prototype; // Построенная схема (не рассчитывается)
+    };
+
+    mutable std::mutex mutex;
+    std::unordered_multimap<uint64_t, Entry> entries; // Хеш -> схема
+    std::string directory;                           // Каталог описаний (пусто - только в памяти)
+
+    uint64_t hits = 0, misses = 0;
+
+    static uint64_t key(uint32_t count, const byte* data, size bytes, Settings settings);
+    std::shared_ptr<const Scheme> find(uint64_t hash, uint32_t count, const byte* data, size bytes,
+                                       Settings settings) const;
+    std::shared_ptr<const Scheme> insert(uint64_t hash, uint32_t count, const byte* data, size bytes,
+                                         Settings settings, bool persist);
+    void store(uint64_t hash, const Entry& entry) const;
+
+public:
+    /**
+     * Экземпляр схемы из кэша.
+     * @param count количество блоков
+     * @param data описание схемы (блоки и связи, формат Scheme::assign())
+     * @param bytes размер описания, включая связи
+     * @param settings настройки построения
+     */
+    std::unique_ptr<Scheme> make(uint32_t count, const byte* data, size bytes, Settings settings);
+
+    std::unique_ptr<Scheme> make(const uint32_t count, const byte* data, const size bytes) {
+        return make(count, data, bytes, Settings{});
+    }
+
+    void setDirectory(const std::string& path);
+    size load();
+    void clear();
+
+    [[nodiscard]] size getSize() const;
+    [[nodiscard]] uint64_t getHits() const;
+    [[nodiscard]] uint64_t getMisses() const;
+};
+}
\ No newline at end of file
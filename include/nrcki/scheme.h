@@ -4,14 +4,30 @@
 #include "context.hpp"
 
 #include "block.h"
+#include "tape.hpp"
+#include "batch.hpp"
+#include "sensitivity.hpp"
+#include "image.hpp"
+#include "worker-pool.hpp"
+#include "task-graph.hpp"
+#include "partition.hpp"
 
 #include <vector>
 #include <memory>
+#include <queue>
 #include <unordered_map>
 #include <map>
+#include <tuple>
+#include <span>
 #include <iostream>
 
 namespace nrcki {
+/// Точность вещественных портов и состояния блоков схемы
+enum class Precision : uint8_t {
+    Double, // double (по умолчанию)
+    Single, // float: вдвое больше значений в строке кэша, для семейств блоков, допускающих float
+};
+
 /// Класс расчётной схемы
 class Scheme final : public Context {
     using Type   = types::real;   // Вещественный тип
@@ -22,45 +38,190 @@ class Scheme final : public Context {
 
     size dt_count     = 0;                      // Число шагов интегрирования
     types::time time  = 0, Time = 0, sync_step; // Абсолютное время
-    size blocks_count = 0;                      // Количество блоков
+    types::time delta = sec * default_dt_sec;   // Шаг интегрирования [мкс]
+    Type delta_sec    = default_dt_sec;         // Шаг интегрирования [сек]
+    Discretization method = Discretization::Euler; // Метод дискретизации динамических звеньев
+    size blocks_count = 0;                      // Количество блоков (без вставленных схемой преобразований типов)
+    bool logic_ports  = false;                  // Логические порты bool (см. setLogicPorts)
+    Precision precision = Precision::Double;    // Точность вещественных портов (см. setPrecision)
+    std::vector<size> assign_offsets;           // Смещения описаний блоков и связей в данных assign(), последнее - размер данных
+
+    /// Арена: вся память расчёта одним выделением (выходы портов по типам, индексы входов блоков, буферы сигналов)
+    struct Section {
+        size offset = 0, bytes = 0; // Смещение от начала арены и размер [байт]
+    };
+
+    static constexpr size arena_alignment = 64; // Выравнивание участков (строка кэша)
+    std::vector<byte> arena;
+    byte* arena_base = nullptr; // Начало арены, выровненное по arena_alignment
+    size arena_size  = 0;
+    std::map<size, Section> port_sections; // type_hash -> участок выходов
+    Section input_tables, input_signals, output_signals;
 
     /// Выделение памяти для портов:
-    std::unordered_map<size, std::vector<byte>> port_memory; /// Байты выходных портов
-    std::unordered_map<size, size> total_outputs;            /// Количество выходных портов: type_hash -> count
+    std::unordered_map<size, std::span<byte>> port_memory;       /// Байты выходных портов (участки арены)
+    std::unordered_map<size, size> total_outputs;                /// Количество выходных портов: type_hash -> count
+    std::vector<Block*> memory_layout;                           /// Блоки, чьи выходы размещаются первыми (в этом порядке)
+    bool is_graph_layout = false;                                /// Раскладка памяти портов по графу расчёта (см. layoutMemory)
+    std::unordered_map<size, std::vector<byte>> initial_memory;  /// Образ памяти портов после построения (см. reset)
+    std::vector<byte> initial_state;                             /// Образ состояния блоков после построения
 
     /// Выделение памяти для сигналов:
-    std::vector<double> input_buffer;  // весь внешний вход схемы (непрерывно)
-    std::vector<double> output_buffer; // весь внешний выход схемы
+    std::span<double> input_buffer;  // весь внешний вход схемы (непрерывно, участок арены)
+    std::span<double> output_buffer; // весь внешний выход схемы (участок арены)
 
-    /// Абсолютная и относительная индексация:
-    std::vector<std::pair<size, void*>> absolute_output_index;          // index -> [type_hash, ptr]
-    std::unordered_map<size, std::vector<void*>> relative_output_index; // type_hash -> index -> ptr
+    /// Абсолютная и относительная индексация (относительный индекс выхода - слот в port_memory его типа):
+    std::vector<std::pair<size, void*>> absolute_output_index; // index -> [type_hash, ptr]
 
     std::vector<std::pair<size, size>> absolute_input_index; // index -> [block, abs_index]
     std::unordered_map<size, std::vector<std::pair<size, size>>> relative_input_index;
     // type_hash -> index -> [block, abs_index]
 
-    std::unordered_map<void*, PortInfo> ports_info;
+    PortsInfo ports_info;
 
     /// Блоки:
     std::vector<std::unique_ptr<Block>> blocks;
     std::unordered_map<string, Type> parameters;
 
     std::unordered_map<size, std::vector<size>> direct_graph;
+    std::map<std::tuple<size, size, size>, size> casts; // [блок, выход, тип входа] -> вставленный блок преобразования
+
+    /// Связь: абсолютный выход блока -> абсолютный вход блока
+    struct Connection {
+        size producer, output, consumer, input;
+    };
     std::vector<Block*> sorted_blocks, active_sorted_blocks, compute_sorted_blocks;
 
     struct FrozenPort {
         void* original = nullptr;
-        double* value  = nullptr;
+        size value     = 0; // Слот значения в запасе участка вещественных портов
     };
 
     std::map<std::pair<size, size>, FrozenPort> frozen_ports;
+    size frozen_capacity = 0;      // Запас слотов для значений замороженных входов (после выходов вещественного типа)
+    std::vector<size> free_frozen; // Свободные слоты запаса
+
+    /// Лента инструкций (альтернативный движок расчёта):
+    Tape tape;
+    bool is_tape_compiled = false;
+
+    /// Уровни (волновые фронты) порядка расчёта: блоки одного уровня независимы
+    std::vector<std::vector<Block*>> compute_levels;
+    std::vector<std::vector<size>> compute_dependencies; // Позиция в compute_sorted_blocks -> обязательные предшественники
+
+    /// Параллельный расчёт по уровням:
+    struct Stage {
+        size begin = 0, end = 0; // Диапазон в level_blocks
+        bool is_parallel = false;
+    };
+
+    std::vector<Block*> level_blocks; // Блоки, упорядоченные по уровням
+    std::vector<Stage> stages;        // Мелкие соседние уровни объединены в последовательные этапы
+    std::unique_ptr<WorkerPool> pool;
+    size min_parallel_level = 64; // Минимальный размер уровня для параллельного расчёта
+
+    /// Граф задач (расчёт с перехватом работы):
+    TaskGraph task_graph;
+    bool is_task_graph_built = false;
+
+    /// Компоненты связности (независимые подсистемы):
+    struct Component {
+        std::vector<Block*> order;                // Порядок расчёта компоненты
+        std::unique_ptr<PartitionContext> context; // Собственное время компоненты
+    };
+
+    std::vector<Component> components;
+    std::vector<std::vector<size>> component_groups; // Поток -> компоненты
+    bool is_partitioned = false;
+
+    /// Событийный расчёт (только блоки с изменившимися входами):
+    struct EventOutput {
+        byte* data = nullptr;
+        size bytes = 0;
+    };
+
+    std::vector<std::vector<size>> event_consumers;      // Позиция в compute_sorted_blocks -> позиции читающих блоков
+    std::vector<std::vector<EventOutput>> event_outputs; // Позиция -> участки памяти выходов
+    std::vector<uint8_t> event_dirty;                    // Бит 0 - расчёт на текущем шаге, бит 1 - на следующем
+    std::vector<byte> event_snapshot;                    // Выходы блока до расчёта
+    size event_step     = 0;                             // dt_count после последнего событийного расчёта
+    size event_computed = 0;                             // Число рассчитанных блоков за последний вызов
+
+    /// Календарь таймеров: (срок, позиция) - минимальная куча, устаревшие записи пропускаются по event_deadlines
+    using TimerEntry = std::pair<types::time, size>;
+    std::priority_queue<TimerEntry, std::vector<TimerEntry>, std::greater<>> event_calendar;
+    std::vector<types::time> event_deadlines; // Позиция -> актуальный срок таймера
+
+    /// Ускоренный расчёт установившегося режима:
+    Type steady_tolerance = 0; // Допустимое суммарное изменение выходов и состояния блоков, пропущенное за вызов
+    size skipped_steps    = 0; // Число пропущенных шагов за последний вызов
+    bool is_event_graph_built = false;
+
+    /// Многочастотный расчёт (блоки с периодом дискретизации больше шага интегрирования):
+    static constexpr size max_hyperperiod = 4096;    // Максимальная длина расписания
+    std::vector<std::vector<Block*>> rate_schedule; // Фаза гиперпериода -> блоки, рассчитываемые на ней
+    bool is_multirate = false;
 
     void build_signals();
+    void connect(std::vector<Connection> connections);
+    std::unique_ptr<Block> make_cast(size from, size to) const;
+
+    // Блок B с вещественными портами float или double (по точности схемы)
+    template <template <typename> class B, typename... Args>
+    std::unique_ptr<Block> make_real(Args&&... args) {
+        if (precision == Precision::Single)
+            return std::make_unique<B<float>>(*this, std::forward<Args>(args)...);
+        return std::make_unique<B<Type>>(*this, std::forward<Args>(args)...);
+    }
+
+    // Блок B с логическими портами bool или вещественными (по режиму и точности схемы)
+    template <template <typename> class B, typename... Args>
+    std::unique_ptr<Block> make_logic(Args&&... args) {
+        if (logic_ports)
+            return std::make_unique<B<bool>>(*this, std::forward<Args>(args)...);
+        return make_real<B>(std::forward<Args>(args)...);
+    }
+
+    // Сравнение B: логический выход, вещественные входы
+    template <template <typename, typename> class B>
+    std::unique_ptr<Block> make_comparator() {
+        const bool single = precision == Precision::Single;
+        if (logic_ports)
+            return single ? std::unique_ptr<Block>(std::make_unique<B<bool, float>>(*this))
+                          : std::unique_ptr<Block>(std::make_unique<B<bool, Type>>(*this));
+        return single ? std::unique_ptr<Block>(std::make_unique<B<float, float>>(*this))
+                      : std::unique_ptr<Block>(std::make_unique<B<Type, Type>>(*this));
+    }
 
+    void read_blocks(uint32_t count, const uint8_t*& data, const uint8_t* begin, std::vector<size>& offsets,
+                     const uint8_t* end);
+    void read_description(uint32_t count, const uint8_t* data, const uint8_t* end);
     void init_indices();
     void allocate_memory();
+    void layout_arena();
+    void place_arena();
+    void bind_inputs(const std::vector<Block*>& order);
+    std::vector<Block*> execution_order() const;
+    void relocate_arena();
+    void retarget(const std::function<void*(void*)>& translate);
+    double* frozen_value(size index);
+    void assign_port_memory();
+    void relayout_memory(const std::vector<Block*>& order);
+    void layout_execution_order();
     void compute_calculation_order();
+    void compute_levels_order();
+    void build_stages();
+    void build_components();
+    void group_components();
+    void compute_components(uint64_t steps);
+    void build_event_graph();
+    bool is_steady(Type tolerance) const;
+    types::time next_deadline();
+    void build_rate_schedule();
+    void compute_multirate(uint64_t steps);
+    void visit_state(const std::function<void(void*, size)>& visit);
+    void capture_initial_state();
+    std::vector<size> block_instructions();
 
     // Абсолютная индексация
     template <typename T>
@@ -74,24 +235,31 @@ class Scheme final : public Context {
     // Относительная индексация
     template <typename T>
     T* get_relative_output_port(const size index) const {
-        const auto hash = types::type_hash<T>();
-        if (auto it = relative_output_index.find(hash); it != relative_output_index.end())
-            if (index < total_outputs.at(hash))
-                return static_cast<T*>(it->second[index]);
+        if (const auto it = port_memory.find(types::type_hash<T>()); it != port_memory.end())
+            if (index < it->second.size() / sizeof(T))
+                return reinterpret_cast<T*>(it->second.data()) + index;
         return nullptr;
     }
 
 public:
-    Scheme() : Context(time, ports_info, blocks) {
+    Scheme() : Context(time, delta, delta_sec, method, ports_info, blocks) {
     }
 
     ~Scheme() override = default;
 
-    void setSteps(const double sync, double delta_time) {
-        sync_step = sync * Context::sec;
-    }
+    std::unique_ptr<Scheme> fork() const;
+
+    void setSteps(double sync, double delta_time);
+    void setDiscretization(Discretization value);
+    void setLogicPorts(bool enable);
+    bool isLogicPorts() const { return logic_ports; }
+    void setPrecision(Precision value);
+    Precision getPrecision() const { return precision; }
 
     void assign(uint32_t count, const uint8_t* data);
+    void assign(uint32_t count, const uint8_t* data, size bytes);
+    const std::vector<size>& getAssignOffsets() const { return assign_offsets; }
+    void reassignBlocks(const uint8_t* data, const std::vector<size>& indices);
 
     constexpr Type parameter(const string& name) const override {
         return parameters.at(name);
@@ -183,6 +351,51 @@ public:
     void compute(uint64_t steps = 1);
     void computeSync(uint64_t steps = 1);
 
+    void compileTape();
+    void computeTape(uint64_t steps = 1);
+    const Tape& getTape() const { return tape; }
+    Batch makeBatch(size lanes);
+    Sensitivity makeSensitivity(const std::vector<Sensitivity::Parameter>& varied);
+    std::vector<byte> getImage();
+    void saveImage(const std::string& path);
+
+    void setThreads(size count, size min_level_size = 64);
+    void computeParallel(uint64_t steps = 1);
+    void computeTasks(uint64_t steps = 1);
+
+    void partition(bool enable = true);
+    void layoutMemory(bool enable = true);
+    size getComponentCount() const { return components.size(); }
+
+    void setSamplePeriod(size block_index, size period, size offset = 0);
+    bool isMultirate() const { return is_multirate; }
+
+    void computeEvents(uint64_t steps = 1);
+    size getEventComputeCount() const { return event_computed; }
+
+    void setSteadyTolerance(Type tolerance) { steady_tolerance = tolerance; }
+    void computeFastForward(uint64_t steps = 1);
+    size getSkippedSteps() const { return skipped_steps; }
+
+    void reset();
+    size getStateSize();
+    size getArenaSize() const { return arena_size; }
+
+    /// Локальность памяти портов за один проход порядка расчёта (чтения входов и записи выходов блоков)
+    struct LayoutMetrics {
+        size accesses      = 0;    // Обращений к памяти портов
+        size line_switches = 0;    // Переходов на другую строку кэша между соседними обращениями
+        size lines         = 0;    // Различных строк кэша
+        double input_distance = 0; // Среднее расстояние от читаемого входа до выходов читающего блока [байт]
+    };
+
+    LayoutMetrics getLayoutMetrics() const;
+    std::vector<byte> saveState();
+    void restoreState(const std::vector<byte>& state);
+
+    const std::vector<std::vector<Block*>>& getComputeLevels() const { return compute_levels; }
+    const TaskGraph& getTaskGraph() const { return task_graph; }
+
     const std::unordered_map<size, size>& getPortsCount() const { return total_outputs; }
     const std::vector<Block*>& getSortedBlocks() const { return sorted_blocks; }
     const std::vector<Block*>& getActiveBlocks() const { return active_sorted_blocks; }
@@ -195,9 +408,18 @@ public:
         std::cout << '\n';
     }
 
+    /// Количество абсолютных выходов схемы (без вставленных блоков преобразования типов)
+    size getAbsoluteOutputCount() const { return absolute_output_index.size(); }
+
     template <typename T>
     T getAbsoluteOutputPort(const size index) const {
         const auto [hash, ptr] = absolute_output_index[index];
+        if (hash != types::type_hash<T>()) { // Логический выход или выход другой точности
+            if (hash == types::type_hash<bool>())
+                return static_cast<T>(*static_cast<const bool*>(ptr));
+            if (hash == types::type_hash<float>())
+                return static_cast<T>(*static_cast<const float*>(ptr));
+        }
         return *static_cast<T*>(ptr);
     }
 
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "constants/config.hxx"
+
+#include <cmath>
+#include <cstddef>
+
+namespace nrcki {
+/**
+ * Пакет из N значений фиксированной ширины (полосы SIMD-регистра): операции выполняются по полосам
+ * независимыми циклами постоянной длины, которые компилятор переводит в векторные инструкции.
+ * Сравнения возвращают маску Pack<bool, N>, ветвление по полосам - select().
+ * Скаляр неявно размножается по полосам, поэтому ядра (kernels.hpp) принимают пакеты наравне со скалярами.
+ */
+template <typename T, std::size_t N>
+struct Pack {
+    T lane[N];
+
+    Pack() = default;
+
+    Pack(const T value) {
+        for (std::size_t i = 0; i < N; ++i)
+            lane[i] = value;
+    }
+
+    static Pack load(const T* data) {
+        Pack result;
+        for (std::size_t i = 0; i < N; ++i)
+            result.lane[i] = data[i];
+        return result;
+    }
+
+    void store(T* data) const {
+        for (std::size_t i = 0; i < N; ++i)
+            data[i] = lane[i];
+    }
+
+    T operator[](const std::size_t index) const { return lane[index]; }
+
+    /// Применение f к каждой полосе
+    template <typename R = T, typename F>
+    friend Pack<R, N> map(const Pack& a, F f) {
+        Pack<R, N> result;
+        for (std::size_t i = 0; i < N; ++i)
+            result.lane[i] = f(a.lane[i]);
+        return result;
+    }
+
+    template <typename R = T, typename F>
+    friend Pack<R, N> map(const Pack& a, const Pack& b, F f) {
+        Pack<R, N> result;
+        for (std::size_t i = 0; i < N; ++i)
+            result.lane[i] = f(a.lane[i], b.lane[i]);
+        return result;
+    }
+
+    friend Pack operator-(const Pack& a) { return map(a, [](const T x) { return -x; }); }
+
+    friend Pack operator+(const Pack& a, const Pack& b) { return map(a, b, [](const T x, const T y) { return x + y; }); }
+    friend Pack operator-(const Pack& a, const Pack& b) { return map(a, b, [](const T x, const T y) { return x - y; }); }
+    friend Pack operator*(const Pack& a, const Pack& b) { return map(a, b, [](const T x, const T y) { return x * y; }); }
+    friend Pack operator/(const Pack& a, const Pack& b) { return map(a, b, [](const T x, const T y) { return x / y; }); }
+
+    Pack& operator+=(const Pack& other) { return *this = *this + other; }
+    Pack& operator-=(const Pack& other) { return *this = *this - other; }
+    Pack& operator*=(const Pack& other) { return *this = *this * other; }
+    Pack& operator/=(const Pack& other) { return *this = *this / other; }
+
+    friend Pack<bool, N> operator==(const Pack& a, const Pack& b) {
+        return map<bool>(a, b, [](const T x, const T y) { return x == y; });
+    }
+
+    friend Pack<bool, N> operator!=(const Pack& a, const Pack& b) {
+        return map<bool>(a, b, [](const T x, const T y) { return x != y; });
+    }
+
+    friend Pack<bool, N> operator<(const Pack& a, const Pack& b) {
+        return map<bool>(a, b, [](const T x, const T y) { return x < y; });
+    }
+
+    friend Pack<bool, N> operator<=(const Pack& a, const Pack& b) {
+        return map<bool>(a, b, [](const T x, const T y) { return x <= y; });
+    }
+
+    friend Pack<bool, N> operator>(const Pack& a, const Pack& b) {
+        return map<bool>(a, b, [](const T x, const T y) { return x > y; });
+    }
+
+    friend Pack<bool, N> operator>=(const Pack& a, const Pack& b) {
+        return map<bool>(a, b, [](const T x, const T y) { return x >= y; });
+    }
+
+    friend Pack abs(const Pack& a) { return map(a, [](const T x) { return std::abs(x); }); }
+    friend Pack sin(const Pack& a) { return map(a, [](const T x) { return std::sin(x); }); }
+    friend Pack cos(const Pack& a) { return map(a, [](const T x) { return std::cos(x); }); }
+    friend Pack exp(const Pack& a) { return map(a, [](const T x) { return std::exp(x); }); }
+    friend Pack log(const Pack& a) { return map(a, [](const T x) { return std::log(x); }); }
+    friend Pack sqrt(const Pack& a) { return map(a, [](const T x) { return std::sqrt(x); }); }
+};
+
+/// Выбор по маске: полоса a, где mask истинна, иначе полоса b
+template <typename T, std::size_t N>
+Pack<T, N> select(const Pack<bool, N>& mask, const Pack<T, N>& a, const Pack<T, N>& b) {
+    Pack<T, N> result;
+    for (std::size_t i = 0; i < N; ++i)
+        result.lane[i] = mask.lane[i] ? a.lane[i] : b.lane[i];
+    return result;
+}
+}
\ No newline at end of file
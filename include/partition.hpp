@@ -0,0 +1,28 @@
+#pragma once
+
+#include "constants/config.hxx"
+#include "context.hpp"
+
+namespace nrcki {
+/// Контекст компоненты связности схемы: собственное время расчёта, шаг, индексы портов и блоки - общие со схемой
+class PartitionContext final : public Context {
+    using Type   = types::real;
+    using string = types::string;
+
+    types::time partition_time = 0;
+    const Context& scheme;
+
+public:
+    explicit PartitionContext(const Context& owner) :
+        Context(partition_time, owner.dt, owner.dt_sec, owner.discretization, owner.ports_info, owner.blocks),
+        scheme(owner) {
+    }
+
+    void setTime(const types::time value) { partition_time = value; }
+    void advance(const types::time delta) { partition_time += delta; }
+
+    [[nodiscard]] Type parameter(const string& name) const override {
+        return scheme.parameter(name);
+    }
+};
+}
\ No newline at end of file
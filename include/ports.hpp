@@ -8,6 +8,9 @@ class PortsBase {
     using size = types::size;
 
 public:
+    using slot = uint32_t;                                   // Индекс слота в участке памяти портов типа
+    static constexpr slot unlinked = static_cast<slot>(-1); // Вход не подключён
+
     const size input_count;
     const size output_count;
 
@@ -18,6 +21,13 @@ public:
 
     virtual ~PortsBase() = default;
 
+    [[nodiscard]] virtual PortsBase* clone() const = 0;
+
+    // Перенос таблицы индексов входов (input_count слотов) во внешнюю память, например в арену схемы,
+    // base - начало участка памяти портов типа, от которого отсчитываются индексы
+    virtual void bindInputs(slot* table, void* base) = 0;
+    [[nodiscard]] virtual const slot* getInputSlots() const = 0;
+
     virtual void allocate(void* data) = 0;
 
     [[nodiscard]] virtual size getTypeHash() const = 0;
@@ -32,17 +42,54 @@ public:
     [[nodiscard]] virtual void* getOutputPort(size index) const = 0;
 };
 
+/// Входы порта: индексы слотов в участке памяти портов типа T, inputs[i] - адрес i-го входа
+template <typename T>
+struct Inputs {
+    using slot = PortsBase::slot;
+
+    slot* slots = nullptr;
+    T* base     = nullptr;
+
+    T* operator[](const types::size index) const {
+        return base + slots[index];
+    }
+};
+
 template <typename T>
 class Ports final : public PortsBase {
     using size = types::size;
 
+    std::vector<slot> own_slots; // Собственная таблица входов (до размещения в арене)
+
 public:
-    std::vector<T*> inputs;
+    Inputs<T> inputs; // Таблица входов: собственная или участок арены схемы
     T* outputs = nullptr;
 
     Ports(const size in, const size out) :
         PortsBase(in, out),
-        inputs(in) {
+        own_slots(in, unlinked),
+        inputs{own_slots.data()} {
+    }
+
+    // Копия получает собственную таблицу входов с теми же индексами и той же базой
+    Ports(const Ports& other) :
+        PortsBase(other),
+        own_slots(other.inputs.slots, other.inputs.slots + other.input_count),
+        inputs{own_slots.data(), other.inputs.base},
+        outputs(other.outputs) {
+    }
+
+    [[nodiscard]] PortsBase* clone() const override {
+        return new Ports(*this);
+    }
+
+    void bindInputs(slot* table, void* base) override {
+        inputs = {table, static_cast<T*>(base)};
+        std::vector<slot>().swap(own_slots);
+    }
+
+    [[nodiscard]] const slot* getInputSlots() const override {
+        return inputs.slots;
     }
 
     void allocate(void* data) override {
@@ -58,11 +105,11 @@ public:
     }
 
     void setInputPort(size index, void* port) override {
-        inputs[index] = static_cast<T*>(port);
+        inputs.slots[index] = port ? static_cast<slot>(static_cast<T*>(port) - inputs.base) : unlinked;
     }
 
     [[nodiscard]] void* getInputPort(size index) const override {
-        return inputs[index];
+        return inputs.slots[index] == unlinked ? nullptr : inputs[index];
     }
 
     [[nodiscard]] void* getOutputPort(size index) const override {
@@ -70,4 +117,4 @@ public:
     }
 
 };
-}
\ No newline at end of file
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "constants/config.hxx"
+#include "tape.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace nrcki {
+/**
+ * Анализ чувствительности прямым методом: производные всех вещественных портов по выбранным
+ * параметрам блоков рассчитываются вместе со значениями за один проход по ленте в дуальных числах.
+ * Параметр - параметр блока (Block::getParameters(): k, T, b, y0 динамических звеньев, узлы характеристики),
+ * либо встроенный параметр инструкции блока (раскладка - см. Tape::run), если блок своих параметров не задаёт.
+ * Дискретные коэффициенты инструкции пересчитываются блоком из параметров в дуальных числах (Block::lowerTangent()),
+ * поэтому производные берутся непосредственно по параметрам блока.
+ * Производные по tangent_width параметрам переносит одно дуальное число,
+ * при большем числе параметров лента выполняется отдельным проходом на каждую группу.
+ */
+class Sensitivity {
+    using Type    = types::real;
+    using size    = types::size;
+    using Tangent = Tape::Tangent;
+
+public:
+    /// Параметр: индекс index параметров блока block
+    struct Parameter {
+        size block = 0, index = 0;
+    };
+
+private:
+    Tape tape;
+    size parameters; // Количество параметров
+
+    std::vector<std::vector<Tangent>> memory; // Группа -> слоты портов
+    std::vector<std::vector<Tangent>> state;  // Группа -> состояние
+    std::vector<std::vector<Tangent>> params; // Группа -> параметры
+    std::vector<Type> inputs;                 // Внешние входы
+
+    size dt_count    = 0; // Число шагов интегрирования
+    types::time time = 0; // Абсолютное время
+    types::time dt   = 0; // Шаг интегрирования схемы
+
+public:
+    Sensitivity(const Tape& compiled, const Type* ports_memory, std::vector<Type> signals,
+                const std::vector<size>& block_instructions, types::time start, types::time step, bool initial,
+                const std::vector<Parameter>& varied);
+
+    void compute(uint64_t steps = 1);
+
+    [[nodiscard]] size getParameterCount() const { return parameters; }
+    [[nodiscard]] size getSteps() const { return dt_count; }
+    [[nodiscard]] types::time getTime() const { return time; }
+
+    /// Относительная индексация вещественных выходных портов
+    [[nodiscard]] Type getOutput(const size index) const { return memory[0][index].value; }
+
+    /// Производная выхода index по параметру parameter (номер в списке параметров)
+    [[nodiscard]] Type getDerivative(const size index, const size parameter) const {
+        return memory[parameter / Tape::tangent_width][index].grad[parameter % Tape::tangent_width];
+    }
+
+    void setInput(const size index, const Type value) { inputs[index] = value; }
+};
+}
\ No newline at end of file
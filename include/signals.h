@@ -7,6 +7,8 @@ class SignalsBase {
 public:
     virtual ~SignalsBase() = default;
 
+    [[nodiscard]] virtual SignalsBase* clone() const = 0;
+
     [[nodiscard]] virtual size_t getNumInputs() const = 0;
     [[nodiscard]] virtual size_t getNumOutputs() const = 0;
     virtual void setInputPointer(void* ptr) = 0;
@@ -15,8 +17,8 @@ public:
     [[nodiscard]] virtual size_t getInputOffset() const = 0;
     [[nodiscard]] virtual size_t getOutputOffset() const = 0;
 
-    virtual void setInputOffset(size_t off);
-    virtual void setOutputOffset(size_t off);
+    virtual void setInputOffset(size_t off) = 0;
+    virtual void setOutputOffset(size_t off) = 0;
 };
 
 template <typename T = double>
@@ -33,6 +35,8 @@ public:
         : n_inputs(num_in), n_outputs(num_out) {
     }
 
+    [[nodiscard]] SignalsBase* clone() const override { return new Signals(*this); }
+
     [[nodiscard]] size_t getNumInputs() const override { return n_inputs; }
     [[nodiscard]] size_t getNumOutputs() const override { return n_outputs; }
 
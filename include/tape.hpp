@@ -0,0 +1,160 @@
+#pragma once
+
+#include "constants/config.hxx"
+#include "dual.hpp"
+#include "ports.hpp"
+
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace nrcki {
+class Block;
+
+/// Лента инструкций: плоское представление порядка расчёта схемы
+class Tape {
+    using Type = types::real;
+    using size = types::size;
+
+public:
+    using slot = uint32_t;
+
+    static constexpr size tangent_width = nrcki::tangent_width;
+    using Tangent                       = nrcki::Tangent;
+
+    /// Коды операций ленты
+    enum class Op : uint8_t {
+        Call, // Вызов виртуального Block::compute() (блок без понижения)
+        // Сигналы
+        Input,
+        Copy,
+        // Операторы
+        Summator,
+        Multiplier,
+        Divider,
+        AbsoluteValue,
+        Negate,
+        Sign,
+        // Логические
+        And,
+        Or,
+        Xor,
+        AndNot,
+        OrNot,
+        XorNot,
+        Not,
+        Equal,
+        NotEqual,
+        Less,
+        Greater,
+        LessOrEqual,
+        GreaterOrEqual,
+        // Нелинейные
+        Saturation,
+        Deadband,
+        Hysteresis,
+        LowThreshold,
+        HighThreshold,
+        // Интерполяция
+        PiecewiseLinearSL,
+        PiecewiseLinearEL,
+        PiecewiseLinearSB,
+        PiecewiseLinearEB,
+        // Ключи и триггеры
+        ToggleSwitch,
+        RsTrigger,
+        SrTrigger,
+        // Динамические
+        Integrator,
+        Inertial,
+        InertialDifferential,
+        Oscillatory,
+        StepDelay,
+        // Источники
+        Step,
+        LinearSource,
+        SinusSource,
+    };
+
+    /// Инструкция: код операции, слоты операндов и смещения параметров/состояния
+    struct Instruction {
+        Op op;
+        slot count;         // Число входных операндов
+        slot out;           // Первый выходной слот
+        slot in;            // Смещение входных слотов в operands
+        slot param;         // Смещение параметров в params
+        slot state;         // Смещение состояния в state
+        const Block* block; // Исходный блок
+    };
+
+    /// Размеры инструкции: входные операнды, встроенные параметры и состояние (выходной слот - один)
+    struct Extent {
+        size operands = 0, params = 0, state = 0;
+    };
+
+private:
+    std::vector<Instruction> code;
+    std::vector<slot> operands; // Входные слоты всех инструкций (непрерывно)
+    std::vector<Type> params;   // Встроенные параметры всех инструкций
+    std::vector<Type> state;    // Внутреннее состояние понижённых блоков
+    std::vector<Type*> origins; // Адреса состояния в блоках: state[i] <-> *origins[i]
+
+    const Type* memory = nullptr; // Память вещественных выходных портов схемы
+    size memory_size   = 0;
+
+    template <typename Value, bool Batched>
+    static void run(std::span<const Instruction> code, const slot* operands, Value* m, Value* s, const Value* p,
+                    const Type* inputs, types::time time, size lanes);
+    template <typename Value, bool Batched>
+    void init(Value* m, Value* s, const Value* p, const Type* inputs, types::time time, size lanes) const;
+
+public:
+    void clear(const Type* ports_memory, size count);
+
+    /// Индекс слота порта, либо -1, если порт вне памяти схемы
+    [[nodiscard]] slot slotOf(const Type* port) const {
+        return port >= memory && port < memory + memory_size ? static_cast<slot>(port - memory) : static_cast<slot>(-1);
+    }
+
+    bool emit(Op op, const Block* block, const Ports<Type>* ports,
+              const std::vector<Type>& parameters = {}, const std::vector<Type*>& states = {});
+
+    /// Порты другого типа (логические bool, вещественные float) лента не адресует: блок рассчитывается вызовом
+    template <typename T, typename Parameters = std::vector<Type>>
+    bool emit(Op, const Block*, const Ports<T>*,
+              const Parameters& = {}, const std::vector<T*>& = {}) { return false; }
+
+    bool emitInput(const Block* block, const Ports<Type>* ports, size signal_index);
+    void call(const Block* block);
+
+    /// Синхронизация состояния ленты с блоками
+    void load();
+    void store() const;
+
+    void execute(Type* ports_memory, const Type* inputs, types::time time);
+    void execute(Type* ports_memory, Type* lanes_state, const Type* lanes_params,
+                 const Type* inputs, types::time time, size lanes) const;
+    void execute(Tangent* ports_memory, Tangent* tangent_state, const Tangent* tangent_params,
+                 const Type* inputs, types::time time) const;
+    void initialize(Tangent* ports_memory, Tangent* tangent_state, const Tangent* tangent_params,
+                    const Type* inputs, types::time time) const;
+    void initialize(Type* ports_memory, Type* lanes_state, const Type* lanes_params,
+                    const Type* inputs, types::time time, size lanes) const;
+    static void execute(std::span<const Instruction> code, const slot* operands, Type* ports_memory, Type* state,
+                        const Type* params, const Type* inputs, types::time time);
+
+    [[nodiscard]] const std::vector<Instruction>& getCode() const { return code; }
+    [[nodiscard]] const std::vector<slot>& getOperands() const { return operands; }
+    [[nodiscard]] const std::vector<Type>& getParams() const { return params; }
+    [[nodiscard]] const std::vector<Type>& getState() const { return state; }
+    [[nodiscard]] size getSlotCount() const { return memory_size; }
+    [[nodiscard]] size getCallCount() const;
+
+    /// Границы параметров и состояния инструкции: [начало, конец) в params и state
+    [[nodiscard]] std::pair<size, size> getParamRange(size instruction) const;
+    [[nodiscard]] std::pair<size, size> getStateRange(size instruction) const;
+
+    [[nodiscard]] static Extent extent(const Instruction& ins, const Type* params, size available);
+};
+}
\ No newline at end of file
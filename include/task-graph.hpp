@@ -0,0 +1,76 @@
+#pragma once
+
+#include "constants/config.hxx"
+#include "worker-pool.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace nrcki {
+class Block;
+
+/**
+ * Очередь задач с перехватом (Chase-Lev): владелец кладёт и берёт задачи с конца,
+ * остальные потоки перехватывают с начала. Ёмкость фиксирована числом задач графа,
+ * так как за шаг каждая задача попадает в очереди ровно один раз.
+ */
+class TaskQueue {
+    using size = types::size;
+
+    std::unique_ptr<std::atomic<uint32_t>[]> buffer;
+    size capacity = 0;
+
+    alignas(64) std::atomic<int64_t> top = 0;
+    alignas(64) std::atomic<int64_t> bottom = 0;
+
+public:
+    static constexpr uint32_t empty = static_cast<uint32_t>(-1);
+
+    explicit TaskQueue(size initial_capacity);
+
+    void push(uint32_t task);
+    uint32_t pop();
+    uint32_t steal();
+};
+
+/**
+ * Граф задач порядка расчёта: цепочки блоков с единственной зависимостью объединены в одну задачу,
+ * на каждом шаге готовые задачи (счётчик зависимостей обнулён) выполняются на пуле с перехватом работы.
+ */
+class TaskGraph {
+    using size = types::size;
+
+    struct Task {
+        size begin = 0, end = 0; // Диапазон в task_blocks
+    };
+
+    std::vector<Block*> task_blocks; // Блоки, сгруппированные по задачам
+    std::vector<Task> tasks;
+    std::vector<size> successor_offsets, successors; // Последователи задач (CSR)
+    std::vector<uint32_t> in_degree;                 // Число зависимостей задач
+    std::vector<uint32_t> sources;                   // Задачи без зависимостей
+
+    std::unique_ptr<std::atomic<uint32_t>[]> pending; // Оставшиеся зависимости на текущем шаге
+    std::vector<std::unique_ptr<TaskQueue>> queues;   // Очереди потоков
+    std::atomic<size> remaining = 0;                  // Невыполненные задачи текущего шага
+
+    void reset();
+    void run_worker(size worker, size workers);
+
+public:
+    /**
+     * @param order порядок расчёта
+     * @param dependencies позиции в order, которые должны быть рассчитаны до блока
+     */
+    void build(const std::vector<Block*>& order, const std::vector<std::vector<size>>& dependencies);
+
+    /// Расчёт шагов на пуле; advance() вызывается перед каждым шагом одним потоком
+    void execute(WorkerPool& pool, uint64_t steps, const std::function<void()>& advance);
+
+    [[nodiscard]] size getTaskCount() const { return tasks.size(); }
+    [[nodiscard]] size getBlockCount() const { return task_blocks.size(); }
+};
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "constants/config.hxx"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace nrcki {
+/**
+ * Постоянный пул потоков: задача выполняется одновременно всеми участниками,
+ * вызывающий поток участвует как worker 0. Между задачами потоки спят на atomic::wait.
+ */
+class WorkerPool {
+    using size = types::size;
+
+    std::vector<std::thread> threads;
+    const std::function<void(size)>* task = nullptr;
+
+    std::atomic<uint64_t> generation = 0; // Номер текущей задачи
+    std::atomic<size> running        = 0; // Число потоков, не завершивших задачу
+    std::atomic<bool> stop           = false;
+
+    void loop(size worker);
+
+public:
+    /// @param count число участников (включая вызывающий поток)
+    explicit WorkerPool(size count);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&)            = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    [[nodiscard]] size getCount() const { return threads.size() + 1; }
+
+    /// Выполнение task(worker) на всех участниках с ожиданием завершения
+    void run(const std::function<void(size)>& task);
+};
+}
\ No newline at end of file
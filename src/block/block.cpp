@@ -3,7 +3,9 @@
 #include "block.h"
 #include "ports.hpp"
 
+#include <algorithm>
 #include <map>
+#include <stdexcept>
 
 namespace nrcki {
 using types::size;
@@ -31,6 +33,20 @@ void Block::outputs(std::unordered_map <size, void*> memory) {
         ports->allocate(memory[type_hash]);
 }
 
+Block::Block(const Block& other) :
+    absolute_input_ports(other.absolute_input_ports),
+    absolute_output_ports(other.absolute_output_ports),
+    absolute_output_types(other.absolute_output_types),
+    flags(other.flags),
+    period(other.period),
+    offset(other.offset),
+    context(other.context),
+    id(other.id),
+    signals(other.signals ? other.signals->clone() : nullptr) {
+    for (const auto [type_hash, ports] : other.ports_bases)
+        ports_bases[type_hash] = ports->clone();
+}
+
 Block::~Block() {
     for (auto [type_hash, ports] : ports_bases)
         delete ports;
@@ -45,14 +61,46 @@ void Block::initIndices() {
         total_output_count += ports->output_count;
         sorted_bases[type_hash] = ports;
     }
+    absolute_input_ports.clear();
+    absolute_output_ports.clear();
+    absolute_output_types.clear();
     absolute_input_ports.reserve(total_input_count);
     absolute_output_ports.reserve(total_output_count);
+    absolute_output_types.reserve(total_output_count);
     for (const auto [type_hash, ports] : sorted_bases) {
         for (size i = 0; i < ports->input_count; ++i)
             absolute_input_ports.emplace_back(type_hash, i);
-        for (size i = 0; i < ports->output_count; ++i)
+        for (size i = 0; i < ports->output_count; ++i) {
             absolute_output_ports.emplace_back(ports->getOutputPort(i));
+            absolute_output_types.emplace_back(type_hash);
+        }
+    }
+}
+
+/**
+ * Размещение таблиц индексов входов блока подряд, в порядке абсолютной индексации входов.
+ * Индексы не переносятся: их копирует в участок вызывающий (схема).
+ * @param table начало участка
+ * @param bases начала участков памяти портов по типам
+ * @return конец участка
+ */
+uint32_t* Block::bindInputs(uint32_t* table, const std::unordered_map<size, void*>& bases) {
+    const std::map<size, PortsBase*> sorted_bases(ports_bases.begin(), ports_bases.end());
+    for (const auto [type_hash, ports] : sorted_bases) {
+        const auto it = bases.find(type_hash);
+        ports->bindInputs(table, it != bases.end() ? it->second : nullptr);
+        table += ports->input_count;
     }
+    return table;
+}
+
+/// Индексы входов блока в порядке абсолютной индексации
+std::vector<uint32_t> Block::getInputSlots() const {
+    std::vector<uint32_t> slots;
+    const std::map<size, PortsBase*> sorted_bases(ports_bases.begin(), ports_bases.end());
+    for (const auto [type_hash, ports] : sorted_bases)
+        slots.insert(slots.end(), ports->getInputSlots(), ports->getInputSlots() + ports->input_count);
+    return slots;
 }
 
 void Block::setInputPortAbsolute(const size index, void* port) const {
@@ -80,4 +128,19 @@ void* Block::getInputPortAbsolute(const size index) const {
 const std::vector <void*>& Block::getOutputPortsAbsolute() const {
     return absolute_output_ports;
 }
+
+size Block::getInputIndex(const size type_hash, const size index) const {
+    const auto it = std::ranges::find(absolute_input_ports, std::pair{type_hash, index});
+    if (it == absolute_input_ports.end())
+        throw std::runtime_error("Block: input port index out of range");
+    return it - absolute_input_ports.begin();
+}
+
+/// Выходы одного типа идут в абсолютной индексации подряд (см. initIndices)
+size Block::getOutputIndex(const size type_hash, const size index) const {
+    const auto first = std::ranges::find(absolute_output_types, type_hash) - absolute_output_types.begin();
+    if (first + index >= absolute_output_types.size() || absolute_output_types[first + index] != type_hash)
+        throw std::runtime_error("Block: output port index out of range");
+    return first + index;
+}
 }
\ No newline at end of file
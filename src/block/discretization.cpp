@@ -0,0 +1,119 @@
+#include "discretization.hpp"
+#include "dual.hpp"
+
+#include <cmath>
+
+namespace nrcki::discretization {
+namespace {
+using std::cos, std::cosh, std::exp, std::expm1, std::sin, std::sinh, std::sqrt;
+
+template <typename V>
+using Matrix = V[2][2];
+
+/// Обратная матрица 2x2
+template <typename V>
+void inverse(const Matrix<V>& m, Matrix<V>& result) {
+    const V det  = m[0][0] * m[1][1] - m[0][1] * m[1][0];
+    result[0][0] = m[1][1] / det;
+    result[0][1] = -m[0][1] / det;
+    result[1][0] = -m[1][0] / det;
+    result[1][1] = m[0][0] / det;
+}
+
+/// Произведение матриц 2x2
+template <typename V>
+void multiply(const Matrix<V>& l, const Matrix<V>& r, Matrix<V>& result) {
+    for (int i = 0; i < 2; ++i)
+        for (int j = 0; j < 2; ++j)
+            result[i][j] = l[i][0] * r[0][j] + l[i][1] * r[1][j];
+}
+
+/**
+ * Матричная экспонента exp(a * h) для матрицы 2x2:
+ * exp(a * h) = exp(s * h) * (C * I + S * (a - s * I)), s = tr(a) / 2, d = s² - det(a),
+ * C = cosh(√d * h), S = sinh(√d * h) / √d (d > 0); C = cos(√-d * h), S = sin(√-d * h) / √-d (d < 0); C = 1, S = h (d = 0)
+ */
+template <typename V>
+void exponent(const Matrix<V>& a, const real h, Matrix<V>& result) {
+    const V s   = (a[0][0] + a[1][1]) / 2;
+    const V det = a[0][0] * a[1][1] - a[0][1] * a[1][0];
+    const V d   = s * s - det;
+
+    V c = 1, sh = h;
+    if (d > 0) {
+        const V w = sqrt(d);
+        c         = cosh(w * h);
+        sh        = sinh(w * h) / w;
+    }
+    else if (d < 0) {
+        const V w = sqrt(-d);
+        c         = cos(w * h);
+        sh        = sin(w * h) / w;
+    }
+
+    const V e    = exp(s * h);
+    result[0][0] = e * (c + sh * (a[0][0] - s));
+    result[0][1] = e * sh * a[0][1];
+    result[1][0] = e * sh * a[1][0];
+    result[1][1] = e * (c + sh * (a[1][1] - s));
+}
+}
+
+template <typename V>
+V firstOrder(const Discretization method, const real h, const V& T) {
+    switch (method) {
+        case Discretization::ZeroOrderHold:
+            return -expm1(-h / T);
+        case Discretization::Tustin:
+            return 2 * h / (2 * T + h);
+        case Discretization::Euler:
+        default:
+            return h / T;
+    }
+}
+
+template <typename V>
+StateSpace2<V> secondOrder(const Discretization method, const Matrix<V>& a, const V (&b)[2], const real h) {
+    StateSpace2<V> result{};
+    switch (method) {
+        case Discretization::ZeroOrderHold: {
+            // phi = exp(a * h), gamma = a⁻¹ * (phi - I) * b
+            exponent(a, h, result.phi);
+            Matrix<V> a_inv, delta = {{result.phi[0][0] - 1, result.phi[0][1]}, {result.phi[1][0], result.phi[1][1] - 1}};
+            Matrix<V> m;
+            inverse(a, a_inv);
+            multiply(a_inv, delta, m);
+            for (int i = 0; i < 2; ++i)
+                result.gamma[i] = m[i][0] * b[0] + m[i][1] * b[1];
+            break;
+        }
+        case Discretization::Tustin: {
+            // phi = (I - a * h / 2)⁻¹ * (I + a * h / 2), gamma = (I - a * h / 2)⁻¹ * b * h
+            const real q    = h / 2;
+            Matrix<V> minus = {{1 - a[0][0] * q, -a[0][1] * q}, {-a[1][0] * q, 1 - a[1][1] * q}};
+            Matrix<V> plus  = {{1 + a[0][0] * q, a[0][1] * q}, {a[1][0] * q, 1 + a[1][1] * q}};
+            Matrix<V> minus_inv;
+            inverse(minus, minus_inv);
+            multiply(minus_inv, plus, result.phi);
+            for (int i = 0; i < 2; ++i)
+                result.gamma[i] = (minus_inv[i][0] * b[0] + minus_inv[i][1] * b[1]) * h;
+            break;
+        }
+        case Discretization::Euler:
+        default:
+            // phi = I + a * h, gamma = b * h
+            for (int i = 0; i < 2; ++i) {
+                for (int j = 0; j < 2; ++j)
+                    result.phi[i][j] = (i == j ? 1 : 0) + a[i][j] * h;
+                result.gamma[i] = b[i] * h;
+            }
+            break;
+    }
+    return result;
+}
+
+template real firstOrder(Discretization, real, const real&);
+template Tangent firstOrder(Discretization, real, const Tangent&);
+template StateSpace2<real> secondOrder(Discretization, const Matrix<real>&, const real (&)[2], real);
+template StateSpace2<Tangent> secondOrder(Discretization, const Matrix<Tangent>&, const Tangent (&)[2], real);
+}
\ No newline at end of file
@@ -0,0 +1,203 @@
+#include "nrcki/ensemble.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+
+namespace nrcki {
+using types::size;
+
+Ensemble::Ensemble(const uint32_t blocks_count, const byte* description, const size bytes) : count(blocks_count) {
+    auto scheme = std::make_unique<Scheme>();
+    scheme->assign(count, description, bytes);
+
+    offsets = scheme->getAssignOffsets();
+    data.assign(description, description + offsets.back());
+    prototype = std::move(scheme);
+}
+
+/**
+ * Задание числа потоков.
+ * @param threads число потоков (включая вызывающий), 0 - число аппаратных потоков
+ */
+void Ensemble::setThreads(size threads) {
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    pool = threads > 1 ? std::make_unique<WorkerPool>(threads) : nullptr;
+}
+
+/// Записываемые выходы: абсолютные индексы выходов схемы (блоки преобразования типов не адресуются)
+void Ensemble::setOutputs(std::vector<size> ports) {
+    const auto available = prototype->getAbsoluteOutputCount();
+    if (std::ranges::any_of(ports, [available](const size port) { return port >= available; }))
+        throw std::runtime_error("Ensemble: output port index out of range");
+    outputs = std::move(ports);
+}
+
+void Ensemble::setQuantiles(std::vector<Type> quantile_levels) {
+    if (std::ranges::any_of(quantile_levels, [](const Type level) { return level < 0 || level > 1; }))
+        throw std::runtime_error("Ensemble: quantile level must be in [0, 1]");
+    levels = std::move(quantile_levels);
+}
+
+size Ensemble::parameter_offset(const size block, const size field) const {
+    if (block >= count)
+        throw std::runtime_error("Ensemble: block index out of range");
+    if (field == 0 || offsets[block] + field + sizeof(Type) > offsets[block + 1])
+        throw std::runtime_error("Ensemble: parameter is outside of the block description");
+    return offsets[block] + field;
+}
+
+void Ensemble::addGrid(const size block, const size field, std::vector<Type> grid_values) {
+    if (grid_values.empty())
+        throw std::runtime_error("Ensemble: grid must not be empty");
+    grid.push_back({block, parameter_offset(block, field), std::move(grid_values)});
+}
+
+/// Случайный параметр: Uniform - на [a, b] (a <= b), Normal - среднее a, СКО b (b > 0)
+void Ensemble::addRandom(const size block, const size field, const Law law, const Type a, const Type b) {
+    if (law == Law::Uniform && !(a <= b))
+        throw std::runtime_error("Ensemble: uniform law requires a <= b");
+    if (law == Law::Normal && !(b > 0))
+        throw std::runtime_error("Ensemble: normal law requires a positive standard deviation");
+    random.push_back({block, parameter_offset(block, field), law, a, b});
+}
+
+/**
+ * Число случайных выборок на каждый узел сетки.
+ * Выборка варианта определяется только seed и номером варианта, поэтому не зависит от числа потоков.
+ */
+void Ensemble::setSamples(const size samples_count, const uint64_t random_seed) {
+    if (samples_count == 0)
+        throw std::runtime_error("Ensemble: samples count must be positive");
+    samples = samples_count;
+    seed    = random_seed;
+}
+
+/// Значения варьируемых параметров варианта: сначала сетки, затем случайные параметры
+std::vector<Ensemble::Type> Ensemble::getParameters(const size variant) const {
+    std::vector<Type> result;
+    result.reserve(grid.size() + random.size());
+
+    auto node = variant / samples;
+    for (const auto& [block, offset, grid_values] : grid) {
+        result.push_back(grid_values[node % grid_values.size()]);
+        node /= grid_values.size();
+    }
+
+    // seed_seq берёт младшие 32 бита элемента: обе половины передаются отдельно
+    std::seed_seq sequence{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32),
+                           static_cast<uint32_t>(variant), static_cast<uint32_t>(static_cast<uint64_t>(variant) >> 32)};
+    std::mt19937_64 engine(sequence);
+    for (const auto& [block, offset, law, a, b] : random)
+        result.push_back(law == Law::Uniform
+                             ? std::uniform_real_distribution(a, b)(engine)
+                             : std::normal_distribution(a, b)(engine));
+    return result;
+}
+
+/**
+ * Расчёт всех вариантов.
+ * Выходы записываются каждые record_interval шагов и после последнего шага.
+ * @param steps количество шагов интегрирования каждого варианта
+ * @param record_interval интервал записи в шагах (0 - только после последнего шага)
+ */
+void Ensemble::run(const uint64_t steps, uint64_t record_interval) {
+    if (record_interval == 0 || record_interval > steps)
+        record_interval = std::max<uint64_t>(steps, 1);
+
+    variants = samples;
+    for (const auto& [block, offset, grid_values] : grid)
+        variants *= grid_values.size();
+
+    std::vector<size> varied; // Блоки с варьируемыми параметрами
+    for (const auto& parameter : grid)
+        varied.push_back(parameter.block);
+    for (const auto& parameter : random)
+        varied.push_back(parameter.block);
+    std::ranges::sort(varied);
+    varied.erase(std::ranges::unique(varied).begin(), varied.end());
+    records = (steps + record_interval - 1) / record_interval;
+    values.assign(variants * records * outputs.size(), 0);
+
+    std::atomic<size> next = 0;
+    std::exception_ptr error;
+    std::mutex error_mutex;
+
+    const std::function task = [&](size) {
+        auto variant_data = data;
+        for (size variant; (variant = next.fetch_add(1, std::memory_order_relaxed)) < variants;) {
+            try {
+                const auto parameters = getParameters(variant);
+                size i                = 0;
+                for (const auto& [block, offset, grid_values] : grid)
+                    std::memcpy(variant_data.data() + offset, &parameters[i++], sizeof(Type));
+                for (const auto& [block, offset, law, a, b] : random)
+                    std::memcpy(variant_data.data() + offset, &parameters[i++], sizeof(Type));
+
+                const auto scheme = prototype->fork();
+                if (!varied.empty())
+                    scheme->reassignBlocks(variant_data.data(), varied);
+                if (setup)
+                    setup(*scheme);
+
+                auto* record = values.data() + variant * records * outputs.size();
+                for (uint64_t step = 0; step < steps; step += record_interval) {
+                    scheme->compute(std::min(record_interval, steps - step));
+                    for (const auto port : outputs)
+                        *record++ = scheme->getAbsoluteOutputPort<Type>(port);
+                }
+            }
+            catch (...) {
+                const std::scoped_lock lock(error_mutex);
+                if (!error)
+                    error = std::current_exception();
+                next.store(variants, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    pool ? pool->run(task) : task(0);
+    if (error)
+        std::rethrow_exception(error);
+
+    aggregate();
+}
+
+/// Статистика по вариантам для каждой записи и выхода (квантили - линейная интерполяция порядковых статистик)
+void Ensemble::aggregate() {
+    const size n = outputs.size();
+    statistics.assign(records * n, {});
+    if (variants == 0)
+        return;
+
+    std::vector<Type> sample(variants);
+    for (size record = 0; record < records; ++record)
+        for (size output = 0; output < n; ++output) {
+            for (size variant = 0; variant < variants; ++variant)
+                sample[variant] = getValue(variant, record, output);
+            std::ranges::sort(sample);
+
+            auto& [mean, min, max, quantiles] = statistics[record * n + output];
+            Type sum = 0;
+            for (const auto value : sample)
+                sum += value;
+            mean = sum / static_cast<Type>(variants);
+            min  = sample.front();
+            max  = sample.back();
+
+            quantiles.clear();
+            for (const auto level : levels) {
+                const auto position = level * static_cast<Type>(variants - 1);
+                const auto lower    = static_cast<size>(std::floor(position));
+                const auto upper    = std::min(lower + 1, variants - 1);
+                quantiles.push_back(sample[lower] + (sample[upper] - sample[lower]) * (position - lower));
+            }
+        }
+}
+}
\ No newline at end of file
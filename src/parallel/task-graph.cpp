@@ -0,0 +1,188 @@
+#include "task-graph.hpp"
+#include "block.h"
+
+#include <algorithm>
+#include <barrier>
+#include <thread>
+
+namespace nrcki {
+using types::size;
+
+TaskQueue::TaskQueue(const size initial_capacity) :
+    buffer(std::make_unique<std::atomic<uint32_t>[]>(std::max<size>(initial_capacity, 1))),
+    capacity(std::max<size>(initial_capacity, 1)) {
+}
+
+void TaskQueue::push(const uint32_t task) {
+    const auto b = bottom.load(std::memory_order_relaxed);
+    buffer[static_cast<size>(b) % capacity].store(task, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom.store(b + 1, std::memory_order_relaxed);
+}
+
+uint32_t TaskQueue::pop() {
+    const auto b = bottom.load(std::memory_order_relaxed) - 1;
+    bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto t = top.load(std::memory_order_relaxed);
+
+    if (t > b) {
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return empty;
+    }
+
+    auto task = buffer[static_cast<size>(b) % capacity].load(std::memory_order_relaxed);
+    if (t == b) {
+        // Последний элемент: соревнование с перехватчиками
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            task = empty;
+        bottom.store(b + 1, std::memory_order_relaxed);
+    }
+    return task;
+}
+
+uint32_t TaskQueue::steal() {
+    auto t = top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const auto b = bottom.load(std::memory_order_acquire);
+    if (t >= b)
+        return empty;
+
+    const auto task = buffer[static_cast<size>(t) % capacity].load(std::memory_order_relaxed);
+    if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        return empty;
+    return task;
+}
+
+void TaskGraph::build(const std::vector<Block*>& order, const std::vector<std::vector<size>>& dependencies) {
+    const size n = order.size();
+
+    // Уникальные зависимости и число зависящих блоков
+    auto before = dependencies;
+    std::vector<size> dependents(n, 0);
+    for (auto& list : before) {
+        std::ranges::sort(list);
+        list.erase(std::ranges::unique(list).begin(), list.end());
+        for (const auto j : list)
+            ++dependents[j];
+    }
+
+    // Объединение цепочек: блок с единственной зависимостью от блока с единственным зависящим
+    std::vector<size> task_of(n);
+    std::vector<std::vector<size>> chains;
+    for (size k = 0; k < n; ++k) {
+        if (before[k].size() == 1 && dependents[before[k][0]] == 1) {
+            task_of[k] = task_of[before[k][0]];
+            chains[task_of[k]].push_back(k);
+        }
+        else {
+            task_of[k] = chains.size();
+            chains.push_back({k});
+        }
+    }
+
+    task_blocks.clear();
+    tasks.clear();
+    for (const auto& chain : chains) {
+        tasks.push_back({task_blocks.size(), task_blocks.size() + chain.size()});
+        for (const auto k : chain)
+            task_blocks.push_back(order[k]);
+    }
+
+    std::vector<std::vector<size>> next(chains.size());
+    for (size k = 0; k < n; ++k)
+        for (const auto j : before[k])
+            if (task_of[j] != task_of[k])
+                next[task_of[j]].push_back(task_of[k]);
+
+    in_degree.assign(chains.size(), 0);
+    successor_offsets.assign(1, 0);
+    successors.clear();
+    for (auto& list : next) {
+        std::ranges::sort(list);
+        list.erase(std::ranges::unique(list).begin(), list.end());
+        for (const auto task : list)
+            ++in_degree[task];
+        successors.insert(successors.end(), list.begin(), list.end());
+        successor_offsets.push_back(successors.size());
+    }
+
+    sources.clear();
+    for (size i = 0; i < chains.size(); ++i)
+        if (in_degree[i] == 0)
+            sources.push_back(static_cast<uint32_t>(i));
+
+    pending = std::make_unique<std::atomic<uint32_t>[]>(std::max<size>(chains.size(), 1));
+    queues.clear();
+}
+
+void TaskGraph::reset() {
+    for (size i = 0; i < tasks.size(); ++i)
+        pending[i].store(in_degree[i], std::memory_order_relaxed);
+    remaining.store(tasks.size(), std::memory_order_release);
+}
+
+void TaskGraph::run_worker(const size worker, const size workers) {
+    auto& queue = *queues[worker];
+    for (size i = worker; i < sources.size(); i += workers)
+        queue.push(sources[i]);
+
+    while (remaining.load(std::memory_order_acquire)) {
+        auto task = queue.pop();
+        for (size i = 1; task == TaskQueue::empty && i < workers; ++i)
+            task = queues[(worker + i) % workers]->steal();
+
+        if (task == TaskQueue::empty) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        const auto [begin, end] = tasks[task];
+        for (size k = begin; k < end; ++k)
+            task_blocks[k]->compute();
+
+        for (size i = successor_offsets[task]; i < successor_offsets[task + 1]; ++i)
+            if (pending[successors[i]].fetch_sub(1, std::memory_order_acq_rel) == 1)
+                queue.push(static_cast<uint32_t>(successors[i]));
+
+        remaining.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+/**
+ * Расчёт шагов по графу задач.
+ * Каждый поток начинает с доли задач без зависимостей, выполняет свою очередь с конца
+ * и при её опустошении перехватывает задачи соседей. Шаги разделяются барьером.
+ * @param pool пул потоков
+ * @param steps количество шагов
+ * @param advance подготовка шага (продвижение времени схемы)
+ */
+void TaskGraph::execute(WorkerPool& pool, const uint64_t steps, const std::function<void()>& advance) {
+    if (steps == 0)
+        return;
+
+    const size workers = pool.getCount();
+    if (queues.size() != workers) {
+        queues.clear();
+        for (size i = 0; i < workers; ++i)
+            queues.push_back(std::make_unique<TaskQueue>(tasks.size()));
+    }
+
+    uint64_t step = 0;
+    advance();
+    reset();
+    std::barrier sync(static_cast<std::ptrdiff_t>(workers), [&]() noexcept {
+        if (++step < steps) {
+            advance();
+            reset();
+        }
+    });
+
+    pool.run([&](const size worker) {
+        for (uint64_t i = 0; i < steps; ++i) {
+            run_worker(worker, workers);
+            sync.arrive_and_wait();
+        }
+    });
+}
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+#include "worker-pool.hpp"
+
+namespace nrcki {
+using types::size;
+
+WorkerPool::WorkerPool(const size count) {
+    for (size i = 1; i < count; ++i)
+        threads.emplace_back(&WorkerPool::loop, this, i);
+}
+
+WorkerPool::~WorkerPool() {
+    stop.store(true, std::memory_order_relaxed);
+    generation.fetch_add(1, std::memory_order_release);
+    generation.notify_all();
+    for (auto& thread : threads)
+        thread.join();
+}
+
+void WorkerPool::loop(const size worker) {
+    uint64_t seen = 0;
+    while (true) {
+        generation.wait(seen, std::memory_order_acquire);
+        seen = generation.load(std::memory_order_acquire);
+        if (stop.load(std::memory_order_relaxed))
+            return;
+
+        (*task)(worker);
+        if (running.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            running.notify_one();
+    }
+}
+
+void WorkerPool::run(const std::function<void(size)>& function) {
+    task = &function;
+    running.store(threads.size(), std::memory_order_relaxed);
+    generation.fetch_add(1, std::memory_order_release);
+    generation.notify_all();
+
+    function(0);
+
+    for (auto count = running.load(std::memory_order_acquire); count; count = running.load(std::memory_order_acquire))
+        running.wait(count, std::memory_order_acquire);
+}
+}
\ No newline at end of file
@@ -19,6 +19,7 @@ void types::register_all_types() {
     REGISTER_TYPE(int, ints);
     REGISTER_TYPE(char, chars);
     REGISTER_TYPE(types::real, reals);
+    REGISTER_TYPE(float, floats);
     REGISTER_TYPE(types::time, times);
 
     REGISTER_TYPE(std::vector <bool>, bool_vectors);
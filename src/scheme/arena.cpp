@@ -0,0 +1,171 @@
+#include "nrcki/scheme.h"
+#include "ports.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <unordered_set>
+
+namespace nrcki {
+/**
+ * Раскладка арены схемы. Участки выровнены по строке кэша и идут подряд:
+ * выходы портов по типам (в порядке type_hash; за вещественными - запас для замороженных входов),
+ * 32-битные индексы входов всех блоков, буфер внешних входов, буфер внешних выходов.
+ */
+void Scheme::layout_arena() {
+    size bytes         = 0;
+    const auto section = [&](const size length) {
+        const Section result{(bytes + arena_alignment - 1) / arena_alignment * arena_alignment, length};
+        bytes = result.offset + length;
+        return result;
+    };
+
+    std::map<size, size> counts(total_outputs.begin(), total_outputs.end());
+    if (frozen_capacity)
+        counts[types::type_hash<double>()] += frozen_capacity;
+
+    port_sections.clear();
+    for (const auto& [type_hash, count] : counts)
+        port_sections[type_hash] = section(count * types::type_size(type_hash));
+
+    size input_count = 0, signal_inputs = 0, signal_outputs = 0;
+    for (const auto& block : blocks) {
+        for (const auto [type_hash, count] : block->inputs())
+            input_count += count;
+        if (const auto* signals = block->getSignals()) {
+            signal_inputs  += signals->getNumInputs();
+            signal_outputs += signals->getNumOutputs();
+        }
+    }
+
+    input_tables   = section(input_count * sizeof(PortsBase::slot));
+    input_signals  = section(signal_inputs * sizeof(double));
+    output_signals = section(signal_outputs * sizeof(double));
+    arena_size     = bytes;
+}
+
+/// Выделение арены по раскладке (обнулённой) и привязка к ней памяти портов и буферов сигналов
+void Scheme::place_arena() {
+    arena.assign(arena_size + arena_alignment, 0);
+    const auto address = reinterpret_cast<std::uintptr_t>(arena.data());
+    arena_base = arena.data() + (arena_alignment - address % arena_alignment) % arena_alignment;
+
+    port_memory.clear();
+    std::vector<PortsInfo::Section> info_sections;
+    for (const auto& [type_hash, section] : port_sections) {
+        const auto it    = total_outputs.find(type_hash);
+        const auto count = it != total_outputs.end() ? it->second : 0;
+        port_memory[type_hash] = {arena_base + section.offset, count * types::type_size(type_hash)};
+        info_sections.push_back({type_hash, arena_base + section.offset, count, types::type_size(type_hash)});
+    }
+    ports_info.bind(std::move(info_sections));
+
+    input_buffer  = {reinterpret_cast<double*>(arena_base + input_signals.offset), input_signals.bytes / sizeof(double)};
+    output_buffer = {reinterpret_cast<double*>(arena_base + output_signals.offset), output_signals.bytes / sizeof(double)};
+}
+
+/// Порядок обхода блоков при расчёте: рассчитываемые блоки, затем остальные (константы, неактивные)
+std::vector<Block*> Scheme::execution_order() const {
+    std::vector order(compute_sorted_blocks.begin(), compute_sorted_blocks.end());
+    const std::unordered_set<const Block*> placed(order.begin(), order.end());
+    for (const auto& block : blocks)
+        if (!placed.contains(block.get()))
+            order.push_back(block.get());
+    return order;
+}
+
+/**
+ * Размещение таблиц индексов входов блоков в арене подряд в заданном порядке,
+ * чтобы при расчёте таблицы читались последовательно. Индексы входов сохраняются,
+ * база каждой таблицы - текущий участок памяти портов её типа.
+ * @param order блоки в порядке размещения (все блоки схемы)
+ */
+void Scheme::bind_inputs(const std::vector<Block*>& order) {
+    std::vector<std::vector<PortsBase::slot>> slots(order.size());
+    for (size k = 0; k < order.size(); ++k)
+        slots[k] = order[k]->getInputSlots();
+
+    std::unordered_map<size, void*> bases;
+    for (const auto& [type_hash, bytes] : port_memory)
+        bases[type_hash] = bytes.data();
+
+    auto* table = reinterpret_cast<PortsBase::slot*>(arena_base + input_tables.offset);
+    for (size k = 0; k < order.size(); ++k) {
+        std::ranges::copy(slots[k], table);
+        table = order[k]->bindInputs(table, bases);
+    }
+}
+
+/**
+ * Перенос содержимого арены в новую раскладку (например, при росте запаса замороженных входов).
+ * Значения портов, индексы входов и буферы сигналов копируются, адреса переводятся (см. retarget).
+ */
+void Scheme::relocate_arena() {
+    const auto old_arena    = std::move(arena); // Живёт до конца переноса: из него читаются таблицы входов
+    const auto* old_base    = arena_base;
+    const auto old_sections = port_sections;
+    const std::array old_buffers{input_tables, input_signals, output_signals};
+
+    layout_arena();
+    place_arena();
+
+    const std::array new_buffers{input_tables, input_signals, output_signals};
+    std::vector<std::pair<Section, Section>> moves; // [старый участок, новый участок]
+    for (size i = 0; i < old_buffers.size(); ++i)
+        moves.emplace_back(old_buffers[i], new_buffers[i]);
+    for (const auto& [type_hash, section] : old_sections)
+        moves.emplace_back(section, port_sections.at(type_hash));
+    for (const auto& [from, to] : moves)
+        std::memcpy(arena_base + to.offset, old_base + from.offset, from.bytes);
+
+    retarget([&](void* port) -> void* {
+        const auto* address = static_cast<const byte*>(port);
+        for (const auto& [from, to] : moves)
+            if (address >= old_base + from.offset && address < old_base + from.offset + from.bytes)
+                return arena_base + to.offset + (address - old_base - from.offset);
+        return port;
+    });
+}
+
+/**
+ * Перевод адресов на новую арену (после переноса или в копии схемы): выходы блоков,
+ * неявные входы, сигналы, абсолютные индексы выходов, замороженные порты.
+ * Индексы входов и сведения о портах (привязаны к слотам) не меняются,
+ * таблицы входов перепривязываются к новым участкам. Лента и событийный граф строятся заново.
+ * @param translate старый адрес -> новый (адреса вне арены возвращаются без изменений)
+ */
+void Scheme::retarget(const std::function<void*(void*)>& translate) {
+    for (const auto& block : blocks) {
+        std::unordered_map<size, void*> memory;
+        for (const auto [type_hash, count] : block->outputs())
+            memory[type_hash] = translate(block->getOutputPortRelative(type_hash, 0));
+        block->outputs(memory);
+        block->visitImplicitInputs(translate);
+
+        if (auto* signals = block->getSignals()) {
+            if (signals->getNumInputs() > 0)
+                signals->setInputPointer(input_buffer.data() + signals->getInputOffset());
+            if (signals->getNumOutputs() > 0)
+                signals->setOutputPointer(output_buffer.data() + signals->getOutputOffset());
+        }
+        block->initIndices();
+    }
+
+    for (auto& [key, frozen] : frozen_ports)
+        frozen.original = translate(frozen.original);
+
+    for (auto& [type_hash, port] : absolute_output_index)
+        port = translate(port);
+
+    bind_inputs(execution_order());
+    is_tape_compiled     = false;
+    is_event_graph_built = false;
+}
+
+/// Значение замороженного входа: слот index запаса после выходов вещественного типа
+double* Scheme::frozen_value(const size index) {
+    const auto it = total_outputs.find(types::type_hash<double>());
+    return reinterpret_cast<double*>(arena_base + port_sections.at(types::type_hash<double>()).offset) +
+           (it != total_outputs.end() ? it->second : 0) + index;
+}
+}
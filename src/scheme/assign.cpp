@@ -94,8 +94,32 @@
 #include "blocks/triggers/t-triggers/str-b-trigger.hpp"
 #include "blocks/triggers/t-triggers/str-l-trigger.hpp"
 
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <typeinfo>
+
 namespace nrcki {
-void Scheme::assign(uint32_t count, const uint8_t* data) {
+namespace {
+/// Чтение значения из описания со сдвигом data; end - граница данных (nullptr - без проверки)
+template <typename T>
+void read_value(T& value, const uint8_t*& data, const uint8_t* end) {
+    if (end && end - data < static_cast<std::ptrdiff_t>(sizeof(value)))
+        throw std::runtime_error("Scheme::assign: description is truncated");
+    __builtin_memcpy(&value, data, sizeof(value));
+    data += sizeof(value);
+}
+}
+
+/**
+ * Разбор описаний count блоков (формат assign()) с добавлением блоков в конец blocks.
+ * @param data начало первого описания, после разбора - конец последнего
+ * @param begin начало данных, от которого отсчитываются смещения описаний
+ * @param offsets смещения описаний разобранных блоков
+ * @param end граница данных (nullptr - без проверки): чтение за границей - исключение
+ */
+void Scheme::read_blocks(const uint32_t count, const uint8_t*& data, const uint8_t* begin, std::vector<size>& offsets,
+                         const uint8_t* end) {
     double a, b, f, w, k, T, y0, dy0;
     double T_on, T_off;
 
@@ -112,10 +136,11 @@ void Scheme::assign(uint32_t count, const uint8_t* data) {
 
     char type;
 
-#define read(VAR) __builtin_memcpy(&VAR, data, sizeof(VAR)); data += sizeof(VAR);
+#define read(VAR) read_value(VAR, data, end);
 #define read_arr(VAR) VAR.resize(n); for (auto& item : VAR) { read(item) }
     uint8_t block_id;
     for (size i = 0; i < count; ++i) {
+        offsets.push_back(data - begin);
         read(block_id)
         switch (static_cast<BlockID>(block_id)) {
             case BlockID::DelayOn: read(type)
@@ -123,7 +148,7 @@ void Scheme::assign(uint32_t count, const uint8_t* data) {
                     blocks.push_back(std::make_unique<DelayOnDynamic>(*this));
                 else {
                     read(T)
-                    blocks.push_back(std::make_unique<DelayOn>(*this, T));
+                    blocks.push_back(make_logic<DelayOn>(T));
                 }
                 break;
             case BlockID::DelayOff: read(type)
@@ -131,7 +156,7 @@ void Scheme::assign(uint32_t count, const uint8_t* data) {
                     blocks.push_back(std::make_unique<DelayOffDynamic>(*this));
                 else {
                     read(T)
-                    blocks.push_back(std::make_unique<DelayOff>(*this, T));
+                    blocks.push_back(make_logic<DelayOff>(T));
                 }
                 break;
             case BlockID::DelayOnOff: read(type)
@@ -140,26 +165,26 @@ void Scheme::assign(uint32_t count, const uint8_t* data) {
                 else {
                     read(T_on)
                     read(T_off)
-                    blocks.push_back(std::make_unique<DelayOnOff>(*this, T_on, T_off));
+                    blocks.push_back(make_logic<DelayOnOff>(T_on, T_off));
                 }
                 break;
 
             case BlockID::Integrator:
                 read(k)
                 read(y0)
-                blocks.push_back(std::make_unique<Integrator>(*this, k, y0));
+                blocks.push_back(make_real<Integrator>(k, y0));
                 break;
             case BlockID::Inertial:
                 read(k)
                 read(T)
                 read(y0)
-                blocks.push_back(std::make_unique<Inertial>(*this, k, T, y0));
+                blocks.push_back(make_real<Inertial>(k, T, y0));
                 break;
             case BlockID::InertialDifferential:
                 read(k)
                 read(T)
                 read(y0)
-                blocks.push_back(std::make_unique<InertialDifferential>(*this, k, T, y0));
+                blocks.push_back(make_real<InertialDifferential>(k, T, y0));
                 break;
             case BlockID::Oscillatory:
                 read(k)
@@ -167,10 +192,10 @@ void Scheme::assign(uint32_t count, const uint8_t* data) {
                 read(b)
                 read(y0)
                 read(dy0)
-                blocks.push_back(std::make_unique<Oscillatory>(*this, k, T, b, y0, dy0));
+                blocks.push_back(make_real<Oscillatory>(k, T, b, y0, dy0));
                 break;
             case BlockID::StepDelay: read(y0)
-                blocks.push_back(std::make_unique<StepDelay>(*this, y0));
+                blocks.push_back(make_real<StepDelay>(y0));
                 break;
 
             case BlockID::PiecewiseLinear:
@@ -178,53 +203,53 @@ void Scheme::assign(uint32_t count, const uint8_t* data) {
                 read_arr(x)
                 read_arr(y)
                 read(is_extra_bound)
-                blocks.push_back(std::make_unique<PiecewiseLinear>(*this, x, y, is_extra_bound));
+                blocks.push_back(make_real<PiecewiseLinear>(x, y, is_extra_bound));
                 break;
 
             case BlockID::Or:
                 read(n)
                 read(bin_state_y0)
                 if (bin_state_y0)
-                    blocks.push_back(std::make_unique<OrNot>(*this, n));
+                    blocks.push_back(make_logic<OrNot>(n));
                 else
-                    blocks.push_back(std::make_unique<Or>(*this, n));
+                    blocks.push_back(make_logic<Or>(n));
                 break;
             case BlockID::And:
                 read(n)
                 read(bin_state_y0)
                 if (bin_state_y0)
-                    blocks.push_back(std::make_unique<AndNot>(*this, n));
+                    blocks.push_back(make_logic<AndNot>(n));
                 else
-                    blocks.push_back(std::make_unique<And>(*this, n));
+                    blocks.push_back(make_logic<And>(n));
                 break;
             case BlockID::Xor:
                 read(n)
                 read(bin_state_y0)
                 if (bin_state_y0)
-                    blocks.push_back(std::make_unique<XorNot>(*this, n));
+                    blocks.push_back(make_logic<XorNot>(n));
                 else
-                    blocks.push_back(std::make_unique<Xor>(*this, n));
+                    blocks.push_back(make_logic<Xor>(n));
                 break;
             case BlockID::Not:
-                blocks.push_back(std::make_unique<Not>(*this));
+                blocks.push_back(make_logic<Not>());
                 break;
             case BlockID::Equal:
-                blocks.push_back(std::make_unique<Equal>(*this));
+                blocks.push_back(make_comparator<Equal>());
                 break;
             case BlockID::NotEqual:
-                blocks.push_back(std::make_unique<NotEqual>(*this));
+                blocks.push_back(make_comparator<NotEqual>());
                 break;
             case BlockID::Less:
-                blocks.push_back(std::make_unique<Less>(*this));
+                blocks.push_back(make_comparator<Less>());
                 break;
             case BlockID::Greater:
-                blocks.push_back(std::make_unique<Greater>(*this));
+                blocks.push_back(make_comparator<Greater>());
                 break;
             case BlockID::LessOrEqual:
-                blocks.push_back(std::make_unique<LessOrEqual>(*this));
+                blocks.push_back(make_comparator<LessOrEqual>());
                 break;
             case BlockID::GreaterOrEqual:
-                blocks.push_back(std::make_unique<GreaterOrEqual>(*this));
+                blocks.push_back(make_comparator<GreaterOrEqual>());
                 break;
 
             case BlockID::Saturation:
@@ -232,13 +257,13 @@ void Scheme::assign(uint32_t count, const uint8_t* data) {
                 read(x2)
                 read(y1)
                 read(y2)
-                blocks.push_back(std::make_unique<Saturation>(*this, x1, x2, y1, y2));
+                blocks.push_back(make_real<Saturation>(x1, x2, y1, y2));
                 break;
             case BlockID::Deadband:
                 read(x1)
                 read(x2)
                 read(k)
-                blocks.push_back(std::make_unique<Deadband>(*this, x1, x2, k));
+                blocks.push_back(make_real<Deadband>(x1, x2, k));
                 break;
             case BlockID::SaturationDeadband:
                 read(x1)
@@ -247,14 +272,14 @@ void Scheme::assign(uint32_t count, const uint8_t* data) {
                 read(y2)
                 read(db_x1)
                 read(db_x2)
-                blocks.push_back(std::make_unique<SaturationDeadband>(*this, x1, x2, y1, y2, db_x1, db_x2));
+                blocks.push_back(make_real<SaturationDeadband>(x1, x2, y1, y2, db_x1, db_x2));
                 break;
             case BlockID::Hysteresis: read(type)
                 if (type == 1) {
                     read(y1)
                     read(y2)
                     read(bin_state_y0)
-                    blocks.push_back(std::make_unique<HysteresisDynamic>(*this, y1, y2, bin_state_y0));
+                    blocks.push_back(make_real<HysteresisDynamic>(y1, y2, bin_state_y0));
                 }
                 else {
                     read(x1)
@@ -262,7 +287,7 @@ void Scheme::assign(uint32_t count, const uint8_t* data) {
                     read(y1)
                     read(y2)
                     read(bin_state_y0)
-                    blocks.push_back(std::make_unique<Hysteresis>(*this, x1, x2, y1, y2, bin_state_y0));
+                    blocks.push_back(make_real<Hysteresis>(x1, x2, y1, y2, bin_state_y0));
                 }
                 break;
             case BlockID::HysteresisDeadband: read(x1)
@@ -273,51 +298,51 @@ void Scheme::assign(uint32_t count, const uint8_t* data) {
                 read(db_x2)
                 read(tern_state_y0)
                 blocks.push_back(
-                    std::make_unique<HysteresisDeadband>(*this, x1, x2, y1, y2, db_x1, db_x2, tern_state_y0));
+                    make_real<HysteresisDeadband>(x1, x2, y1, y2, db_x1, db_x2, tern_state_y0));
                 break;
             case BlockID::LowThreshold:
                 read(x1)
                 read(x2)
-                blocks.push_back(std::make_unique<LowThreshold>(*this, x1, x2));
+                blocks.push_back(make_real<LowThreshold>(x1, x2));
                 break;
             case BlockID::HighThreshold:
                 read(x1)
                 read(x2)
-                blocks.push_back(std::make_unique<HighThreshold>(*this, x1, x2));
+                blocks.push_back(make_real<HighThreshold>(x1, x2));
                 break;
             case BlockID::VariableHysteresis:
-                blocks.push_back(std::make_unique<VariableHysteresis>(*this));
+                blocks.push_back(make_real<VariableHysteresis>());
                 break;
             case BlockID::VariableHysteresisPlus:
-                blocks.push_back(std::make_unique<VariableHysteresisPlus>(*this));
+                blocks.push_back(make_real<VariableHysteresisPlus>());
                 break;
             case BlockID::VariableHysteresisMinus:
-                blocks.push_back(std::make_unique<VariableHysteresisMinus>(*this));
+                blocks.push_back(make_real<VariableHysteresisMinus>());
                 break;
 
             case BlockID::Summator:
                 read(n)
                 read_arr(coeffs)
-                blocks.push_back(std::make_unique<Summator>(*this, coeffs));
+                blocks.push_back(make_real<Summator>(coeffs));
                 break;
             case BlockID::Multiplier: read(n)
-                blocks.push_back(std::make_unique<Multiplier>(*this, n));
+                blocks.push_back(make_real<Multiplier>(n));
                 break;
             case BlockID::Divider: read(value_if_div_null)
-                blocks.push_back(std::make_unique<Divider>(*this, value_if_div_null));
+                blocks.push_back(make_real<Divider>(value_if_div_null));
                 break;
             case BlockID::AbsoluteValue:
-                blocks.push_back(std::make_unique<AbsoluteValue>(*this));
+                blocks.push_back(make_real<AbsoluteValue>());
                 break;
             case BlockID::Sign:
-                blocks.push_back(std::make_unique<Sign>(*this));
+                blocks.push_back(make_real<Sign>());
                 break;
 
             case BlockID::RisingPulse:
-                blocks.push_back(std::make_unique<RisingPulse>(*this));
+                blocks.push_back(make_logic<RisingPulse>());
                 break;
             case BlockID::FallingPulse:
-                blocks.push_back(std::make_unique<FallingPulse>(*this));
+                blocks.push_back(make_logic<FallingPulse>());
                 break;
             case BlockID::Pulse: read(type)
                 if (type == 1) {
@@ -325,7 +350,7 @@ void Scheme::assign(uint32_t count, const uint8_t* data) {
                 }
                 else {
                     read(T)
-                    blocks.push_back(std::make_unique<Pulse>(*this, T));
+                    blocks.push_back(make_logic<Pulse>(T));
                 }
                 break;
             case BlockID::ShortPulse: read(type)
@@ -334,7 +359,7 @@ void Scheme::assign(uint32_t count, const uint8_t* data) {
                 }
                 else {
                     read(T)
-                    blocks.push_back(std::make_unique<ShortPulse>(*this, T));
+                    blocks.push_back(make_logic<ShortPulse>(T));
                 }
                 break;
             case BlockID::LongPulse: read(type)
@@ -343,17 +368,17 @@ void Scheme::assign(uint32_t count, const uint8_t* data) {
                 }
                 else {
                     read(T)
-                    blocks.push_back(std::make_unique<LongPulse>(*this, T));
+                    blocks.push_back(make_logic<LongPulse>(T));
                 }
                 break;
             case BlockID::DebounceOn: read(T)
-                blocks.push_back(std::make_unique<DebounceOn>(*this, T));
+                blocks.push_back(make_logic<DebounceOn>(T));
                 break;
             case BlockID::DebounceOff: read(T)
-                blocks.push_back(std::make_unique<DebounceOff>(*this, T));
+                blocks.push_back(make_logic<DebounceOff>(T));
                 break;
             case BlockID::DebounceOnOff: read(T)
-                blocks.push_back(std::make_unique<DebounceOnOff>(*this, T));
+                blocks.push_back(make_logic<DebounceOnOff>(T));
                 break;
 
             case BlockID::ExtInSignal: read(y0)
@@ -374,32 +399,32 @@ void Scheme::assign(uint32_t count, const uint8_t* data) {
                 break;
 
             case BlockID::Constant: read(y0)
-                blocks.push_back(std::make_unique<Constant>(*this, y0));
+                blocks.push_back(make_real<Constant>(y0));
                 break;
             case BlockID::Step: read(T)
                 read(b)
                 read(y0)
-                blocks.push_back(std::make_unique<Step>(*this, T, b, y0));
+                blocks.push_back(make_real<Step>(T, b, y0));
                 break;
             case BlockID::LinearSource: read(k)
                 read(b)
-                blocks.push_back(std::make_unique<LinearSource>(*this, k, b));
+                blocks.push_back(make_real<LinearSource>(k, b));
                 break;
             case BlockID::SinusSource: read(a)
                 read(w)
                 read(f)
-                blocks.push_back(std::make_unique<SinusSource>(*this, a, w, f));
+                blocks.push_back(make_real<SinusSource>(a, w, f));
                 break;
 
             case BlockID::ToggleSwitch:
-                blocks.push_back(std::make_unique<ToggleSwitch>(*this));
+                blocks.push_back(make_real<ToggleSwitch>());
                 break;
 
             case BlockID::RsTrigger: read(bin_state_y0)
-                blocks.push_back(std::make_unique<RsTrigger>(*this, bin_state_y0));
+                blocks.push_back(make_logic<RsTrigger>(bin_state_y0));
                 break;
             case BlockID::SrTrigger: read(bin_state_y0)
-                blocks.push_back(std::make_unique<SrTrigger>(*this, bin_state_y0));
+                blocks.push_back(make_logic<SrTrigger>(bin_state_y0));
                 break;
 
             case BlockID::TTrigger: read(type)
@@ -407,19 +432,19 @@ void Scheme::assign(uint32_t count, const uint8_t* data) {
                 switch (type) {
                     case 'r':
                     case 0:
-                        blocks.push_back(std::make_unique<TTriggerR>(*this, bin_state_y0));
+                        blocks.push_back(make_logic<TTriggerR>(bin_state_y0));
                         break;
                     case 'f':
                     case 1:
-                        blocks.push_back(std::make_unique<TTriggerF>(*this, bin_state_y0));
+                        blocks.push_back(make_logic<TTriggerF>(bin_state_y0));
                         break;
                     case 'b':
                     case 2:
-                        blocks.push_back(std::make_unique<TTriggerB>(*this, bin_state_y0));
+                        blocks.push_back(make_logic<TTriggerB>(bin_state_y0));
                         break;
                     case 'l':
                     case 3:
-                        blocks.push_back(std::make_unique<TTriggerL>(*this, bin_state_y0));
+                        blocks.push_back(make_logic<TTriggerL>(bin_state_y0));
                         break;
                     default:
                         std::cerr << "Scheme::assign: неверный тип T-триггера\n"
@@ -432,19 +457,19 @@ void Scheme::assign(uint32_t count, const uint8_t* data) {
                 switch (type) {
                     case 'r':
                     case 0:
-                        blocks.push_back(std::make_unique<RtsRTrigger>(*this, bin_state_y0));
+                        blocks.push_back(make_logic<RtsRTrigger>(bin_state_y0));
                         break;
                     case 'f':
                     case 1:
-                        blocks.push_back(std::make_unique<RtsFTrigger>(*this, bin_state_y0));
+                        blocks.push_back(make_logic<RtsFTrigger>(bin_state_y0));
                         break;
                     case 'b':
                     case 2:
-                        blocks.push_back(std::make_unique<RtsBTrigger>(*this, bin_state_y0));
+                        blocks.push_back(make_logic<RtsBTrigger>(bin_state_y0));
                         break;
                     case 'l':
                     case 3:
-                        blocks.push_back(std::make_unique<RtsLTrigger>(*this, bin_state_y0));
+                        blocks.push_back(make_logic<RtsLTrigger>(bin_state_y0));
                         break;
                     default:
                         std::cerr << "Scheme::assign: неверный тип T-триггера\n"
@@ -456,19 +481,19 @@ void Scheme::assign(uint32_t count, const uint8_t* data) {
                 switch (type) {
                     case 'r':
                     case 0:
-                        blocks.push_back(std::make_unique<StrRTrigger>(*this, bin_state_y0));
+                        blocks.push_back(make_logic<StrRTrigger>(bin_state_y0));
                         break;
                     case 'f':
                     case 1:
-                        blocks.push_back(std::make_unique<StrFTrigger>(*this, bin_state_y0));
+                        blocks.push_back(make_logic<StrFTrigger>(bin_state_y0));
                         break;
                     case 'b':
                     case 2:
-                        blocks.push_back(std::make_unique<StrBTrigger>(*this, bin_state_y0));
+                        blocks.push_back(make_logic<StrBTrigger>(bin_state_y0));
                         break;
                     case 'l':
                     case 3:
-                        blocks.push_back(std::make_unique<StrLTrigger>(*this, bin_state_y0));
+                        blocks.push_back(make_logic<StrLTrigger>(bin_state_y0));
                         break;
                     default:
                         std::cerr << "Scheme::assign: неверный тип T-триггера\n"
@@ -481,8 +506,20 @@ void Scheme::assign(uint32_t count, const uint8_t* data) {
                     << "i: " << i << ", block-id: " << int(block_id) << '\n';
         }
     }
+}
+
+/// Построение схемы по описанию; end - граница описания (nullptr - без проверки)
+void Scheme::read_description(const uint32_t count, const uint8_t* data, const uint8_t* end) {
+    const auto* begin = data;
+    assign_offsets.clear();
+    read_blocks(count, data, begin, assign_offsets, end);
+
+    assign_offsets.push_back(data - begin);
     link links;
     read(links)
+    if (end && static_cast<size>(end - data) / (2 * sizeof(link)) < links)
+        throw std::runtime_error("Scheme::assign: description is truncated");
+    assign_offsets.push_back(data - begin + 2 * links * sizeof(link));
 
 #undef read
 #undef read_arr
@@ -490,4 +527,120 @@ void Scheme::assign(uint32_t count, const uint8_t* data) {
     blocks_count = count;
     setAbsoluteLinks(links, reinterpret_cast<const link*>(data));
 }
-}
\ No newline at end of file
+
+void Scheme::assign(const uint32_t count, const uint8_t* data) {
+    read_description(count, data, nullptr);
+}
+
+/**
+ * Построение схемы по описанию известного размера (например, из файла): разбор не выходит за bytes,
+ * размер описания должен совпадать с bytes.
+ */
+void Scheme::assign(const uint32_t count, const uint8_t* data, const size bytes) {
+    read_description(count, data, data + bytes);
+    if (assign_offsets.back() != bytes)
+        throw std::runtime_error("Scheme::assign: description size does not match the scheme");
+}
+
+/**
+ * Замена блоков новыми описаниями без перестроения схемы (например, с другими значениями параметров).
+ * Блок разбирается из своего описания в data (формат assign(), смещения - getAssignOffsets())
+ * и должен совпадать с прежним по типу и числу портов: связи, память портов, порядок расчёта,
+ * периоды дискретизации и свёртка констант сохраняются. Начальные значения всех блоков пересчитываются
+ * в порядке расчёта, как при построении, и схема возвращается в начальное состояние (см. reset).
+ * Блоки внешних сигналов не заменяются.
+ * @param data описание схемы той же структуры, что и при построении
+ * @param indices индексы заменяемых блоков
+ */
+void Scheme::reassignBlocks(const uint8_t* data, const std::vector<size>& indices) {
+    if (assign_offsets.size() != blocks_count + 2)
+        throw std::runtime_error("reassignBlocks: scheme was not built by assign()");
+
+    std::unordered_map<size, void*> bases;
+    for (const auto& [type_hash, bytes] : port_memory)
+        bases[type_hash] = bytes.data();
+
+    std::vector<std::unique_ptr<Block>> replaced; // Прежние блоки живут до перевода порядков расчёта
+    std::vector<std::vector<PortsBase::slot>> tables; // Индексы входов новых блоков до размещения в арене
+    tables.reserve(indices.size());
+    std::unordered_map<const Block*, Block*> block_of;
+    std::vector unique(indices.begin(), indices.end());
+    std::ranges::sort(unique);
+    unique.erase(std::ranges::unique(unique).begin(), unique.end());
+    for (const auto index : unique) {
+        if (index >= blocks_count)
+            throw std::runtime_error("reassignBlocks: block index out of range");
+
+        if (blocks[index]->getSignals())
+            throw std::runtime_error("reassignBlocks: signal blocks cannot be replaced");
+
+        const auto total        = blocks.size();
+        const auto* description = data + assign_offsets[index];
+        std::vector<size> offsets;
+        read_blocks(1, description, data, offsets, data + assign_offsets[index + 1]);
+        if (blocks.size() == total)
+            throw std::runtime_error("reassignBlocks: unknown block in the description");
+        auto fresh = std::move(blocks.back());
+        blocks.pop_back();
+
+        auto& block = blocks[index];
+
+        if (typeid(*fresh) != typeid(*block) || fresh->inputs() != block->inputs() ||
+            fresh->outputs() != block->outputs() || fresh->getSignals())
+            throw std::runtime_error("reassignBlocks: block description does not match the scheme");
+
+        // Выходы - на месте прежних, индексы входов - прежние
+        std::unordered_map<size, void*> memory;
+        for (const auto [type_hash, count] : block->outputs())
+            if (count)
+                memory[type_hash] = block->getOutputPortRelative(type_hash, 0);
+        fresh->outputs(memory);
+        fresh->initIndices();
+        fresh->bindInputs(tables.emplace_back(block->getInputSlots()).data(), bases);
+
+        fresh->setContext(block->getContext());
+        if (block->getPeriod() != 1)
+            fresh->setPeriod(block->getPeriod(), block->getOffset());
+        if (block->isConstant())
+            fresh->tryMakeConstant();
+
+        block_of[block.get()] = fresh.get();
+        replaced.push_back(std::move(block));
+        block = std::move(fresh);
+    }
+
+    const auto map_blocks = [&](std::vector<Block*>& order) {
+        for (auto& block : order)
+            if (const auto it = block_of.find(block); it != block_of.end())
+                block = it->second;
+    };
+
+    map_blocks(memory_layout);
+    map_blocks(sorted_blocks);
+    map_blocks(active_sorted_blocks);
+    map_blocks(compute_sorted_blocks);
+    map_blocks(level_blocks);
+    for (auto& level : compute_levels)
+        map_blocks(level);
+    for (auto& phase : rate_schedule)
+        map_blocks(phase);
+    for (auto& component : components)
+        map_blocks(component.order);
+
+    // Таблицы индексов входов - в арену
+    bind_inputs(execution_order());
+
+    // Начальные значения - как при построении: от обнулённых выходов в порядке расчёта
+    time = 0;
+    for (auto& [type_hash, bytes] : port_memory)
+        std::ranges::fill(bytes, byte{0});
+    for (const auto block : sorted_blocks)
+        block->init();
+    capture_initial_state();
+    reset();
+
+    is_tape_compiled     = false;
+    is_task_graph_built  = false;
+    is_event_graph_built = false;
+}
+}
\ No newline at end of file
@@ -0,0 +1,215 @@
+#include "nrcki/scheme-cache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+namespace nrcki {
+using types::size;
+
+namespace {
+/// Заголовок файла описания схемы в каталоге кэша
+struct FileHeader {
+    static constexpr char signature[8] = {'N', 'R', 'C', 'K', 'I', 'S', 'C', 'H'};
+    static constexpr uint32_t version  = 1;
+
+    char magic[8]{};
+    uint32_t format      = 0;
+    uint32_t count       = 0;
+    uint8_t logic_ports  = 0;
+    uint8_t precision    = 0;
+    uint8_t reserved[6]{};
+    uint64_t bytes       = 0;
+};
+
+constexpr auto extension = ".scheme";
+
+/// Имя файла описания: хеш в шестнадцатеричной записи
+std::string file_name(const uint64_t hash) {
+    char name[17];
+    std::snprintf(name, sizeof name, "%016llx", static_cast<unsigned long long>(hash));
+    return name;
+}
+}
+
+/// FNV-1a (64 бит) по количеству блоков, настройкам и описанию
+uint64_t SchemeCache::key(const uint32_t count, const byte* data, const size bytes, const Settings settings) {
+    uint64_t hash      = 14695981039346656037ull;
+    const auto combine = [&](const byte* first, const size n) {
+        for (size i = 0; i < n; ++i)
+            hash = (hash ^ first[i]) * 1099511628211ull;
+    };
+    const byte prefix[] = {static_cast<byte>(settings.logic_ports), static_cast<byte>(settings.precision)};
+    combine(reinterpret_cast<const byte*>(&count), sizeof count);
+    combine(prefix, sizeof prefix);
+    combine(data, bytes);
+    return hash;
+}
+
+std::shared_ptr<const Scheme> SchemeCache::find(const uint64_t hash, const uint32_t count, const byte* data,
+                                                const size bytes, const Settings settings) const {
+    const auto [first, last] = entries.equal_range(hash);
+    for (auto it = first; it != last; ++it) {
+        const auto& entry = it->second;
+        if (entry.count == count && entry.settings.logic_ports == settings.logic_ports &&
+            entry.settings.precision == settings.precision && entry.data.size() == bytes &&
+            std::memcmp(entry.data.data(), data, bytes) == 0)
+            return entry.prototype;
+    }
+    return nullptr;
+}
+
+/**
+ * Построение прототипа (вне блокировки: разные схемы строятся параллельно) и добавление в кэш.
+ * Если ту же схему уже построил другой поток, используется его прототип.
+ * Ошибка записи в каталог не мешает построению: схема остаётся только в памяти.
+ */
+std::shared_ptr<const Scheme> SchemeCache::insert(const uint64_t hash, const uint32_t count, const byte* data,
+                                                  const size bytes, const Settings settings, const bool persist) {
+    auto scheme = std::make_shared<Scheme>();
+    scheme->setLogicPorts(settings.logic_ports);
+    scheme->setPrecision(settings.precision);
+    scheme->assign(count, data, bytes);
+
+    std::lock_guard lock(mutex);
+    if (auto prototype = find(hash, count, data, bytes, settings))
+        return prototype;
+
+    const auto& entry = entries.emplace(hash, Entry{count, settings, {data, data + bytes}, std::move(scheme)})->second;
+    if (persist && !directory.empty()) {
+        try {
+            store(hash, entry);
+        }
+        catch (const std::exception&) {}
+    }
+    return entry.prototype;
+}
+
+/// Запись описания в каталог (имя файла - хеш), существующий файл не перезаписывается
+void SchemeCache::store(const uint64_t hash, const Entry& entry) const {
+    const auto path = std::filesystem::path(directory) / (file_name(hash) + extension);
+    if (std::filesystem::exists(path))
+        return;
+
+    FileHeader header;
+    std::memcpy(header.magic, FileHeader::signature, sizeof header.magic);
+    header.format      = FileHeader::version;
+    header.count       = entry.count;
+    header.logic_ports = entry.settings.logic_ports;
+    header.precision   = static_cast<uint8_t>(entry.settings.precision);
+    header.bytes       = entry.data.size();
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file)
+        throw std::runtime_error("SchemeCache: cannot open " + path.string());
+    file.write(reinterpret_cast<const char*>(&header), sizeof header);
+    file.write(reinterpret_cast<const char*>(entry.data.data()), static_cast<std::streamsize>(entry.data.size()));
+    if (!file) {
+        file.close();
+        std::error_code error;
+        std::filesystem::remove(path, error); // недописанный файл не должен занимать имя
+        throw std::runtime_error("SchemeCache: cannot write " + path.string());
+    }
+}
+
+std::unique_ptr<Scheme> SchemeCache::make(const uint32_t count, const byte* data, const size bytes,
+                                          const Settings settings) {
+    const auto hash = key(count, data, bytes, settings);
+    std::shared_ptr<const Scheme> prototype;
+    {
+        std::lock_guard lock(mutex);
+        prototype = find(hash, count, data, bytes, settings);
+        prototype ? ++hits : ++misses;
+    }
+    if (!prototype)
+        prototype = insert(hash, count, data, bytes, settings, true);
+    return prototype->fork();
+}
+
+/**
+ * Каталог для хранения описаний схем между запусками. Описания, построенные после вызова, записываются в каталог.
+ * @param path каталог (создаётся при отсутствии), пустая строка - только в памяти
+ */
+void SchemeCache::setDirectory(const std::string& path) {
+    if (!path.empty())
+        std::filesystem::create_directories(path);
+    std::lock_guard lock(mutex);
+    directory = path;
+}
+
+/**
+ * Построение прототипов всех схем, сохранённых в каталоге.
+ * Файлы другого формата, с несовпадающим хешем и с описанием, которое не удаётся построить, пропускаются.
+ * @return количество добавленных схем
+ */
+size SchemeCache::load() {
+    std::string path;
+    {
+        std::lock_guard lock(mutex);
+        path = directory;
+    }
+    if (path.empty())
+        return 0;
+
+    size loaded = 0;
+    for (const auto& file_entry : std::filesystem::directory_iterator(path)) {
+        if (!file_entry.is_regular_file() || file_entry.path().extension() != extension)
+            continue;
+
+        std::ifstream file(file_entry.path(), std::ios::binary);
+        FileHeader header;
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof header) ||
+            std::memcmp(header.magic, FileHeader::signature, sizeof header.magic) ||
+            header.format != FileHeader::version || header.precision > static_cast<uint8_t>(Precision::Single) ||
+            header.bytes != file_entry.file_size() - sizeof header)
+            continue;
+
+        std::vector<byte> data(header.bytes);
+        if (!file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size())))
+            continue;
+
+        const Settings settings{header.logic_ports != 0, static_cast<Precision>(header.precision)};
+        const auto hash = key(header.count, data.data(), data.size(), settings);
+        if (file_entry.path().stem().string() != file_name(hash))
+            continue;
+
+        {
+            std::lock_guard lock(mutex);
+            if (find(hash, header.count, data.data(), data.size(), settings))
+                continue;
+        }
+        try {
+            insert(hash, header.count, data.data(), data.size(), settings, false);
+        }
+        catch (const std::exception&) {
+            continue;
+        }
+        ++loaded;
+    }
+    return loaded;
+}
+
+/// Удаление прототипов из памяти (файлы каталога не удаляются) и сброс счётчиков
+void SchemeCache::clear() {
+    std::lock_guard lock(mutex);
+    entries.clear();
+    hits = misses = 0;
+}
+
+size SchemeCache::getSize() const {
+    std::lock_guard lock(mutex);
+    return entries.size();
+}
+
+uint64_t SchemeCache::getHits() const {
+    std::lock_guard lock(mutex);
+    return hits;
+}
+
+uint64_t SchemeCache::getMisses() const {
+    std::lock_guard lock(mutex);
+    return misses;
+}
+}
\ No newline at end of file
@@ -24,7 +24,7 @@ namespace nrcki {
  */
 void Scheme::addDelayOn(double T) {
     ++blocks_count;
-    blocks.push_back(std::make_unique <DelayOn>(*this, T));
+    blocks.push_back(make_logic<DelayOn>(T));
 }
 
 /**
@@ -46,7 +46,7 @@ void Scheme::addDelayOn(double T) {
  */
 void Scheme::addDelayOff(double T) {
     ++blocks_count;
-    blocks.push_back(std::make_unique <DelayOff>(*this, T));
+    blocks.push_back(make_logic<DelayOff>(T));
 }
 
 /**
@@ -72,6 +72,6 @@ void Scheme::addDelayOff(double T) {
  */
 void Scheme::addDelayOnOff(double T_on, double T_off) {
     ++blocks_count;
-    blocks.push_back(std::make_unique <DelayOnOff>(*this, T_on, T_off));
+    blocks.push_back(make_logic<DelayOnOff>(T_on, T_off));
 }
 }
\ No newline at end of file
@@ -25,7 +25,7 @@ namespace nrcki {
  */
 void Scheme::addIntegrator(double k, double y0) {
     ++blocks_count;
-    blocks.push_back(std::make_unique<Integrator>(*this, k, y0));
+    blocks.push_back(make_real<Integrator>(k, y0));
 }
 
 /**
@@ -47,7 +47,7 @@ void Scheme::addIntegrator(double k, double y0) {
  */
 void Scheme::addInertial(double k, double T, double y0) {
     ++blocks_count;
-    blocks.push_back(std::make_unique<Inertial>(*this, k, T, y0));
+    blocks.push_back(make_real<Inertial>(k, T, y0));
 }
 
 /**
@@ -69,7 +69,7 @@ void Scheme::addInertial(double k, double T, double y0) {
  */
 void Scheme::addInertialDifferential(double k, double T, double y0) {
     ++blocks_count;
-    blocks.push_back(std::make_unique<InertialDifferential>(*this, k, T, y0));
+    blocks.push_back(make_real<InertialDifferential>(k, T, y0));
 }
 
 /**
@@ -95,7 +95,7 @@ void Scheme::addInertialDifferential(double k, double T, double y0) {
  */
 void Scheme::addOscillatory(double k, double T, double b, double y0, double dy0) {
     ++blocks_count;
-    blocks.push_back(std::make_unique<Oscillatory>(*this, k, T, b, y0, dy0));
+    blocks.push_back(make_real<Oscillatory>(k, T, b, y0, dy0));
 }
 
 /**
@@ -118,6 +118,6 @@ void Scheme::addOscillatory(double k, double T, double b, double y0, double dy0)
  */
 void Scheme::addStepDelay(double y0) {
     ++blocks_count;
-    blocks.push_back(std::make_unique<StepDelay>(*this, y0));
+    blocks.push_back(make_real<StepDelay>(y0));
 }
 }
\ No newline at end of file
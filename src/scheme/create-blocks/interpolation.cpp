@@ -39,10 +39,9 @@ namespace nrcki {
  */
 void Scheme::addPiecewiseLinear(int n, double* x, double* y, bool is_extra_bound) {
     ++blocks_count;
-    blocks.push_back(std::make_unique <PiecewiseLinear>(*this,
-                                                        std::vector <types::real>(x, x + n),
-                                                        std::vector <types::real>(y, y + n),
-                                                        is_extra_bound
+    blocks.push_back(make_real<PiecewiseLinear>(std::vector <types::real>(x, x + n),
+                                                std::vector <types::real>(y, y + n),
+                                                is_extra_bound
                      )
     );
 }
@@ -26,7 +26,7 @@ namespace nrcki {
  */
 void Scheme::addAnd(int n) {
     ++blocks_count;
-    blocks.push_back(std::make_unique <And>(*this, n));
+    blocks.push_back(make_logic<And>(n));
 }
 
 /**
@@ -44,7 +44,7 @@ void Scheme::addAnd(int n) {
  */
 void Scheme::addOr(int n) {
     ++blocks_count;
-    blocks.push_back(std::make_unique <Or>(*this, n));
+    blocks.push_back(make_logic<Or>(n));
 }
 
 /**
@@ -55,7 +55,7 @@ void Scheme::addOr(int n) {
  */
 void Scheme::addNot() {
     ++blocks_count;
-    blocks.push_back(std::make_unique <Not>(*this));
+    blocks.push_back(make_logic<Not>());
 }
 
 /**
@@ -66,7 +66,7 @@ void Scheme::addNot() {
  */
 void Scheme::addEqual() {
     ++blocks_count;
-    blocks.push_back(std::make_unique <Equal>(*this));
+    blocks.push_back(make_comparator<Equal>());
 }
 
 /**
@@ -77,7 +77,7 @@ void Scheme::addEqual() {
  */
 void Scheme::addNotEqual() {
     ++blocks_count;
-    blocks.push_back(std::make_unique <NotEqual>(*this));
+    blocks.push_back(make_comparator<NotEqual>());
 }
 
 /**
@@ -88,7 +88,7 @@ void Scheme::addNotEqual() {
  */
 void Scheme::addLess() {
     ++blocks_count;
-    blocks.push_back(std::make_unique <Less>(*this));
+    blocks.push_back(make_comparator<Less>());
 }
 
 /**
@@ -99,7 +99,7 @@ void Scheme::addLess() {
  */
 void Scheme::addLessOrEqual() {
     ++blocks_count;
-    blocks.push_back(std::make_unique <LessOrEqual>(*this));
+    blocks.push_back(make_comparator<LessOrEqual>());
 }
 
 /**
@@ -110,7 +110,7 @@ void Scheme::addLessOrEqual() {
  */
 void Scheme::addGreater() {
     ++blocks_count;
-    blocks.push_back(std::make_unique <Greater>(*this));
+    blocks.push_back(make_comparator<Greater>());
 }
 
 /**
@@ -121,6 +121,6 @@ void Scheme::addGreater() {
  */
 void Scheme::addGreaterOrEqual() {
     ++blocks_count;
-    blocks.push_back(std::make_unique <GreaterOrEqual>(*this));
+    blocks.push_back(make_comparator<GreaterOrEqual>());
 }
 }
\ No newline at end of file
@@ -37,7 +37,7 @@ namespace nrcki {
  */
 void Scheme::addSaturation(double x1, double x2, double y1, double y2) {
     ++blocks_count;
-    blocks.push_back(std::make_unique<Saturation>(*this, x1, x2, y1, y2));
+    blocks.push_back(make_real<Saturation>(x1, x2, y1, y2));
 }
 
 /**
@@ -60,7 +60,7 @@ void Scheme::addSaturation(double x1, double x2, double y1, double y2) {
  */
 void Scheme::addDeadband(double x1, double x2, double k) {
     ++blocks_count;
-    blocks.push_back(std::make_unique<Deadband>(*this, x1, x2, k));
+    blocks.push_back(make_real<Deadband>(x1, x2, k));
 }
 
 /**
@@ -90,7 +90,7 @@ void Scheme::addDeadband(double x1, double x2, double k) {
  */
 void Scheme::addSaturationDeadband(double x1, double x2, double y1, double y2, double db_x1, double db_x2) {
     ++blocks_count;
-    blocks.push_back(std::make_unique<SaturationDeadband>(*this, x1, x2, y1, y2, db_x1, db_x2));
+    blocks.push_back(make_real<SaturationDeadband>(x1, x2, y1, y2, db_x1, db_x2));
 }
 
 /**
@@ -116,7 +116,7 @@ void Scheme::addSaturationDeadband(double x1, double x2, double y1, double y2, d
  */
 void Scheme::addHysteresis(double x1, double x2, double y1, double y2, bool y0) {
     ++blocks_count;
-    blocks.push_back(std::make_unique<Hysteresis>(*this, x1, x2, y1, y2, y0));
+    blocks.push_back(make_real<Hysteresis>(x1, x2, y1, y2, y0));
 }
 
 /**
@@ -142,7 +142,7 @@ void Scheme::addHysteresis(double x1, double x2, double y1, double y2, bool y0)
  */
 void Scheme::addHysteresisDeadband(double x1, double x2, double y1, double y2, double db_x1, double db_x2, int y0) {
     ++blocks_count;
-    blocks.push_back(std::make_unique<HysteresisDeadband>(*this, x1, x2, y1, y2, db_x1, db_x2, y0));
+    blocks.push_back(make_real<HysteresisDeadband>(x1, x2, y1, y2, db_x1, db_x2, y0));
 }
 
 /**
@@ -161,7 +161,7 @@ void Scheme::addHysteresisDeadband(double x1, double x2, double y1, double y2, d
  */
 void Scheme::addLowThreshold(double activation, double deactivation) {
     ++blocks_count;
-    blocks.push_back(std::make_unique<LowThreshold>(*this, activation, deactivation));
+    blocks.push_back(make_real<LowThreshold>(activation, deactivation));
 }
 
 /**
@@ -180,7 +180,7 @@ void Scheme::addLowThreshold(double activation, double deactivation) {
  */
 void Scheme::addHighThreshold(double activation, double deactivation) {
     ++blocks_count;
-    blocks.push_back(std::make_unique<HighThreshold>(*this, activation, deactivation));
+    blocks.push_back(make_real<HighThreshold>(activation, deactivation));
 }
 
 /**
@@ -216,7 +216,7 @@ void Scheme::addHighThreshold(double activation, double deactivation) {
  */
 void Scheme::addVariableHysteresis() {
     ++blocks_count;
-    blocks.push_back(std::make_unique<VariableHysteresis>(*this));
+    blocks.push_back(make_real<VariableHysteresis>());
 }
 
 /**
@@ -250,7 +250,7 @@ void Scheme::addVariableHysteresis() {
  */
 void Scheme::addVariableHysteresisPlus() {
     ++blocks_count;
-    blocks.push_back(std::make_unique<VariableHysteresisPlus>(*this));
+    blocks.push_back(make_real<VariableHysteresisPlus>());
 }
 
 /**
@@ -284,6 +284,6 @@ void Scheme::addVariableHysteresisPlus() {
  */
 void Scheme::addVariableHysteresisMinus() {
     ++blocks_count;
-    blocks.push_back(std::make_unique<VariableHysteresisMinus>(*this));
+    blocks.push_back(make_real<VariableHysteresisMinus>());
 }
 }
\ No newline at end of file
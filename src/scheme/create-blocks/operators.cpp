@@ -15,7 +15,7 @@ using types::real;
  */
 void Scheme::addSummator(int n, double* coefficients) {
     ++blocks_count;
-    blocks.push_back(std::make_unique <Summator>(*this, std::vector <real>(coefficients, coefficients + n)));
+    blocks.push_back(make_real<Summator>(std::vector <real>(coefficients, coefficients + n)));
 }
 
 /**
@@ -25,7 +25,7 @@ void Scheme::addSummator(int n, double* coefficients) {
  */
 void Scheme::addMultiplier(int n) {
     ++blocks_count;
-    blocks.push_back(std::make_unique <Multiplier>(*this, n));
+    blocks.push_back(make_real<Multiplier>(n));
 }
 
 /**
@@ -35,7 +35,7 @@ void Scheme::addMultiplier(int n) {
  */
 void Scheme::addDivider(double value_if_div_null) {
     ++blocks_count;
-    blocks.push_back(std::make_unique <Divider>(*this, value_if_div_null));
+    blocks.push_back(make_real<Divider>(value_if_div_null));
 }
 
 /**
@@ -44,7 +44,7 @@ void Scheme::addDivider(double value_if_div_null) {
  */
 void Scheme::addAbsoluteValue() {
     ++blocks_count;
-    blocks.push_back(std::make_unique <AbsoluteValue>(*this));
+    blocks.push_back(make_real<AbsoluteValue>());
 }
 
 /**
@@ -58,6 +58,6 @@ void Scheme::addAbsoluteValue() {
  */
 void Scheme::addSign() {
     ++blocks_count;
-    blocks.push_back(std::make_unique <Sign>(*this));
+    blocks.push_back(make_real<Sign>());
 }
 }
\ No newline at end of file
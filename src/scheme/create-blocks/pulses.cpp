@@ -25,7 +25,7 @@ namespace nrcki {
  */
 void Scheme::addPulse(double T) {
     ++blocks_count;
-    blocks.push_back(std::make_unique <Pulse>(*this, T));
+    blocks.push_back(make_logic<Pulse>(T));
 }
 
 /**
@@ -41,7 +41,7 @@ void Scheme::addPulse(double T) {
  */
 void Scheme::addRisingPulse() {
     ++blocks_count;
-    blocks.push_back(std::make_unique <RisingPulse>(*this));
+    blocks.push_back(make_logic<RisingPulse>());
 }
 
 /**
@@ -57,7 +57,7 @@ void Scheme::addRisingPulse() {
  */
 void Scheme::addFallingPulse() {
     ++blocks_count;
-    blocks.push_back(std::make_unique <FallingPulse>(*this));
+    blocks.push_back(make_logic<FallingPulse>());
 }
 
 /**
@@ -75,7 +75,7 @@ void Scheme::addFallingPulse() {
  */
 void Scheme::addLongPulse(double T) {
     ++blocks_count;
-    blocks.push_back(std::make_unique <LongPulse>(*this, T));
+    blocks.push_back(make_logic<LongPulse>(T));
 }
 
 /**
@@ -93,7 +93,7 @@ void Scheme::addLongPulse(double T) {
  */
 void Scheme::addShortPulse(double T) {
     ++blocks_count;
-    blocks.push_back(std::make_unique <ShortPulse>(*this, T));
+    blocks.push_back(make_logic<ShortPulse>(T));
 }
 
 /**
@@ -113,13 +113,13 @@ void Scheme::addDebounce(double T, char type) {
     ++blocks_count;
     switch (type) {
         case 'e':
-            blocks.push_back(std::make_unique <DebounceOn>(*this, T));
+            blocks.push_back(make_logic<DebounceOn>(T));
             break;
         case 'd':
-            blocks.push_back(std::make_unique <DebounceOff>(*this, T));
+            blocks.push_back(make_logic<DebounceOff>(T));
             break;
         case 't':
-            blocks.push_back(std::make_unique <DebounceOnOff>(*this, T));
+            blocks.push_back(make_logic<DebounceOnOff>(T));
             break;
     }
 }
@@ -13,7 +13,7 @@ namespace nrcki {
  */
 void Scheme::addConstant(double c) {
     ++blocks_count;
-    blocks.push_back(std::make_unique <Constant>(*this, c));
+    blocks.push_back(make_real<Constant>(c));
 }
 
 /**
@@ -28,7 +28,7 @@ void Scheme::addConstant(double c) {
  */
 void Scheme::addStep(double time, double yk, double y0) {
     ++blocks_count;
-    blocks.push_back(std::make_unique <Step>(*this, time, yk, y0));
+    blocks.push_back(make_real<Step>(time, yk, y0));
 }
 
 /**
@@ -41,7 +41,7 @@ void Scheme::addStep(double time, double yk, double y0) {
  */
 void Scheme::addLinearSource(double k, double b) {
     ++blocks_count;
-    blocks.push_back(std::make_unique <LinearSource>(*this, k, b));
+    blocks.push_back(make_real<LinearSource>(k, b));
 }
 
 /**
@@ -55,6 +55,6 @@ void Scheme::addLinearSource(double k, double b) {
  */
 void Scheme::addSinusSource(double a, double w, double f) {
     ++blocks_count;
-    blocks.push_back(std::make_unique <SinusSource>(*this, a, w, f));
+    blocks.push_back(make_real<SinusSource>(a, w, f));
 }
 }
\ No newline at end of file
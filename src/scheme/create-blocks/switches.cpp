@@ -25,6 +25,6 @@ namespace nrcki {
  */
 void Scheme::addToggleSwitch() {
     ++blocks_count;
-    blocks.push_back(std::make_unique <ToggleSwitch>(*this));
+    blocks.push_back(make_real<ToggleSwitch>());
 }
 }
\ No newline at end of file
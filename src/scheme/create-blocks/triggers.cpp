@@ -42,7 +42,7 @@ namespace nrcki {
  */
 void Scheme::addRsTrigger(bool y0) {
     ++blocks_count;
-    blocks.push_back(std::make_unique<RsTrigger>(*this, y0));
+    blocks.push_back(make_logic<RsTrigger>(y0));
 }
 
 /**
@@ -73,7 +73,7 @@ void Scheme::addRsTrigger(bool y0) {
  */
 void Scheme::addSrTrigger(bool y0) {
     ++blocks_count;
-    blocks.push_back(std::make_unique<SrTrigger>(*this, y0));
+    blocks.push_back(make_logic<SrTrigger>(y0));
 }
 
 /**
@@ -109,16 +109,16 @@ void Scheme::addRtsTrigger(char type, bool y0) {
     ++blocks_count;
     switch (type) {
         case 'r':
-            blocks.push_back(std::make_unique<RtsRTrigger>(*this, y0));
+            blocks.push_back(make_logic<RtsRTrigger>(y0));
             break;
         case 'f':
-            blocks.push_back(std::make_unique<RtsFTrigger>(*this, y0));
+            blocks.push_back(make_logic<RtsFTrigger>(y0));
             break;
         case 'b':
-            blocks.push_back(std::make_unique<RtsBTrigger>(*this, y0));
+            blocks.push_back(make_logic<RtsBTrigger>(y0));
             break;
         case 'l':
-            blocks.push_back(std::make_unique<RtsLTrigger>(*this, y0));
+            blocks.push_back(make_logic<RtsLTrigger>(y0));
             break;
     }
 }
@@ -156,16 +156,16 @@ void Scheme::addStrTrigger(char type, bool y0) {
     ++blocks_count;
     switch (type) {
         case 'r':
-            blocks.push_back(std::make_unique<StrRTrigger>(*this, y0));
+            blocks.push_back(make_logic<StrRTrigger>(y0));
             break;
         case 'f':
-            blocks.push_back(std::make_unique<StrFTrigger>(*this, y0));
+            blocks.push_back(make_logic<StrFTrigger>(y0));
             break;
         case 'b':
-            blocks.push_back(std::make_unique<StrBTrigger>(*this, y0));
+            blocks.push_back(make_logic<StrBTrigger>(y0));
             break;
         case 'l':
-            blocks.push_back(std::make_unique<StrLTrigger>(*this, y0));
+            blocks.push_back(make_logic<StrLTrigger>(y0));
             break;
     }
 }
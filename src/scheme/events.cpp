@@ -0,0 +1,138 @@
+#include "nrcki/scheme.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace nrcki {
+/// Граф распространения изменений: читающие блоки и участки памяти выходов для каждой позиции порядка расчёта
+void Scheme::build_event_graph() {
+    const size n = compute_sorted_blocks.size();
+
+    std::unordered_map<const Block*, size> block_index;
+    for (size i = 0; i < blocks.size(); ++i)
+        block_index[blocks[i].get()] = i;
+
+    std::vector position(blocks.size(), static_cast<size>(-1));
+    for (size i = 0; i < n; ++i)
+        position[block_index[compute_sorted_blocks[i]]] = i;
+
+    event_consumers.assign(n, {});
+    const auto add_link = [&](const size from, const size to) {
+        if (position[from] != static_cast<size>(-1) && position[to] != static_cast<size>(-1))
+            event_consumers[position[from]].push_back(position[to]);
+    };
+
+    for (const auto& [from, consumers] : direct_graph)
+        for (const auto to : consumers)
+            add_link(from, to);
+    for (size k = 0; k < n; ++k)
+        compute_sorted_blocks[k]->visitImplicitInputs([&](void* port) {
+            if (const auto* info = ports_info.find(port))
+                add_link(info->block_index, block_index[compute_sorted_blocks[k]]);
+            return port;
+        });
+
+    size snapshot_size = 0;
+    event_outputs.assign(n, {});
+    for (size k = 0; k < n; ++k) {
+        std::ranges::sort(event_consumers[k]);
+        event_consumers[k].erase(std::ranges::unique(event_consumers[k]).begin(), event_consumers[k].end());
+
+        size bytes = 0;
+        for (const auto [type_hash, count] : compute_sorted_blocks[k]->outputs())
+            if (count) {
+                const auto length = count * types::type_size(type_hash);
+                event_outputs[k].push_back({
+                    static_cast<byte*>(compute_sorted_blocks[k]->getOutputPortRelative(type_hash, 0)), length
+                });
+                bytes += length;
+            }
+        snapshot_size = std::max(snapshot_size, bytes);
+    }
+
+    event_snapshot.resize(snapshot_size);
+    event_dirty.assign(n, 1);
+    event_deadlines.assign(n, std::numeric_limits<types::time>::max());
+    event_calendar = {};
+    is_event_graph_built = true;
+}
+
+/**
+ * Событийный расчёт схемы.
+ * Блоки с флагом EVENT_DRIVEN рассчитываются только на шагах, когда изменился хотя бы один их вход,
+ * блоки с флагом TIMER (задержки, импульсы, антидребезг) - ещё и по сроку таймера из календаря,
+ * остальные (динамические, источники, внешние сигналы) - на каждом шаге.
+ * Изменение выхода обнаруживается сравнением памяти до и после расчёта блока и помечает читающие блоки:
+ * стоящие дальше в порядке расчёта - на текущем шаге, стоящие раньше (разорванные петли) - на следующем.
+ * Результаты совпадают с compute(). При разных периодах дискретизации блоков - обычный compute().
+ * @param steps количество шагов интегрирования
+ */
+void Scheme::computeEvents(const uint64_t steps) {
+    if (is_multirate) {
+        compute(steps);
+        event_computed = 0;
+        return;
+    }
+    if (!is_event_graph_built)
+        build_event_graph();
+    else if (event_step != dt_count) { // Между вызовами схема рассчитывалась другим движком
+        std::ranges::fill(event_dirty, 1);
+        std::ranges::fill(event_deadlines, std::numeric_limits<types::time>::max());
+        event_calendar = {};
+    }
+
+    const size n   = compute_sorted_blocks.size();
+    event_computed = 0;
+    for (uint64_t step = 0; step < steps; ++step) {
+        time += dt;
+        while (!event_calendar.empty() && event_calendar.top().first <= time) {
+            const auto [deadline, k] = event_calendar.top();
+            event_calendar.pop();
+            if (event_deadlines[k] == deadline) {
+                event_deadlines[k] = std::numeric_limits<types::time>::max();
+                event_dirty[k]     |= 1;
+            }
+        }
+
+        for (size k = 0; k < n; ++k) {
+            const auto block = compute_sorted_blocks[k];
+            if ((block->isEventDriven() || block->isTimer()) && !(event_dirty[k] & 1))
+                continue;
+
+            auto* snapshot = event_snapshot.data();
+            for (const auto& [data, bytes] : event_outputs[k]) {
+                std::memcpy(snapshot, data, bytes);
+                snapshot += bytes;
+            }
+
+            block->compute();
+            ++event_computed;
+
+            if (block->isTimer())
+                if (const auto deadline = block->deadline(); deadline != event_deadlines[k]) {
+                    event_deadlines[k] = deadline;
+                    if (deadline != std::numeric_limits<types::time>::max())
+                        event_calendar.emplace(deadline, k);
+                }
+
+            snapshot = event_snapshot.data();
+            bool changed = false;
+            for (const auto& [data, bytes] : event_outputs[k]) {
+                changed  = changed || std::memcmp(snapshot, data, bytes) != 0;
+                snapshot += bytes;
+            }
+
+            if (changed)
+                for (const auto consumer : event_consumers[k])
+                    event_dirty[consumer] |= consumer > k ? 1 : 2;
+        }
+
+        for (auto& dirty : event_dirty)
+            dirty >>= 1;
+    }
+
+    dt_count   += steps;
+    event_step = dt_count;
+}
+}
\ No newline at end of file
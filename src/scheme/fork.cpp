@@ -0,0 +1,99 @@
+#include "nrcki/scheme.h"
+
+#include <cstring>
+
+namespace nrcki {
+/**
+ * Независимая копия схемы (ветвь расчёта) без повторного построения.
+ * Порядок расчёта, уровни, расписание многочастотного расчёта, компоненты и индексы портов переносятся
+ * без сортировки и разбора связей, блоки копируются вместе с параметрами и внутренним состоянием,
+ * выходы, неявные входы и сигналы переводятся на собственную арену копии.
+ * Пул потоков не копируется (каждый поток владеет своей копией), лента и событийный граф
+ * строятся заново при первом обращении.
+ */
+std::unique_ptr<Scheme> Scheme::fork() const {
+    auto copy = std::make_unique<Scheme>();
+
+    copy->dt_count      = dt_count;
+    copy->time          = time;
+    copy->Time          = Time;
+    copy->sync_step     = sync_step;
+    copy->delta         = delta;
+    copy->delta_sec     = delta_sec;
+    copy->method        = method;
+    copy->blocks_count  = blocks_count;
+    copy->total_outputs = total_outputs;
+    copy->parameters    = parameters;
+    copy->direct_graph  = direct_graph;
+    copy->casts         = casts;
+    copy->logic_ports   = logic_ports;
+    copy->precision     = precision;
+
+    copy->assign_offsets       = assign_offsets;
+    copy->initial_memory       = initial_memory;
+    copy->initial_state        = initial_state;
+    copy->absolute_input_index = absolute_input_index;
+    copy->relative_input_index = relative_input_index;
+    copy->compute_dependencies = compute_dependencies;
+    copy->stages               = stages;
+    copy->min_parallel_level   = min_parallel_level;
+    copy->steady_tolerance     = steady_tolerance;
+    copy->is_multirate         = is_multirate;
+    copy->is_graph_layout      = is_graph_layout;
+
+    // Арена копии с той же раскладкой: значения портов и сигналов копируются одним блоком
+    copy->port_sections  = port_sections;
+    copy->input_tables   = input_tables;
+    copy->input_signals  = input_signals;
+    copy->output_signals = output_signals;
+    copy->arena_size     = arena_size;
+    copy->ports_info     = ports_info;
+    copy->place_arena();
+    if (arena_size)
+        std::memcpy(copy->arena_base, arena_base, arena_size);
+
+    copy->absolute_output_index = absolute_output_index;
+    copy->frozen_ports          = frozen_ports;
+    copy->frozen_capacity       = frozen_capacity;
+    copy->free_frozen           = free_frozen;
+
+    std::unordered_map<const Block*, Block*> block_of;
+    copy->blocks.reserve(blocks.size());
+    for (const auto& block : blocks)
+        block_of[block.get()] = copy->blocks.emplace_back(block->clone(*copy)).get();
+
+    const auto map_blocks = [&](const std::vector<Block*>& order) {
+        std::vector<Block*> result;
+        result.reserve(order.size());
+        for (const auto block : order)
+            result.push_back(block_of.at(block));
+        return result;
+    };
+
+    copy->memory_layout         = map_blocks(memory_layout);
+    copy->sorted_blocks         = map_blocks(sorted_blocks);
+    copy->active_sorted_blocks  = map_blocks(active_sorted_blocks);
+    copy->compute_sorted_blocks = map_blocks(compute_sorted_blocks);
+    copy->level_blocks          = map_blocks(level_blocks);
+    for (const auto& level : compute_levels)
+        copy->compute_levels.push_back(map_blocks(level));
+    for (const auto& phase : rate_schedule)
+        copy->rate_schedule.push_back(map_blocks(phase));
+
+    if (is_partitioned) {
+        for (const auto& component : components)
+            copy->components.push_back({map_blocks(component.order), std::make_unique<PartitionContext>(*copy)});
+        copy->is_partitioned = true;
+        copy->group_components();
+    }
+
+    // Адреса арены схемы -> адреса арены копии (индексы входов копируются с ареной)
+    copy->retarget([&](void* port) -> void* {
+        const auto* address = static_cast<const byte*>(port);
+        if (address >= arena_base && address < arena_base + arena_size)
+            return copy->arena_base + (address - arena_base);
+        return port;
+    });
+    return copy;
+}
+}
\ No newline at end of file
@@ -1,19 +1,43 @@
 #include "nrcki/scheme.h"
 
+#include <algorithm>
+#include <stdexcept>
+
 namespace nrcki {
+/**
+ * Заморозка входа: вход переключается на постоянное значение в запасе арены (после выходов вещественного типа).
+ * При исчерпании запас удваивается с переносом арены (см. relocate_arena).
+ */
 void Scheme::freezePort(const size_t block_index, size_t abs_input_port, const double value) {
     const std::pair key{block_index, abs_input_port};
     if (const auto it = frozen_ports.find(key); it != frozen_ports.end()) {
-        *it->second.value = value;
+        *frozen_value(it->second.value) = value;
+        is_event_graph_built = false;
         return;
     }
 
-    const auto* block  = blocks[block_index].get();
+    const auto* block = blocks[block_index].get();
+    if (block->getInputType(abs_input_port) != types::type_hash<double>())
+        throw std::runtime_error("freezePort: only real inputs can be frozen");
+
+    if (free_frozen.empty()) {
+        const auto capacity = std::max<size>(8, frozen_capacity * 2);
+        for (auto index = capacity; index-- > frozen_capacity;)
+            free_frozen.push_back(index);
+        frozen_capacity = capacity;
+        relocate_arena();
+    }
+    const auto index = free_frozen.back();
+    free_frozen.pop_back();
+
     void* original_ptr = block->getInputPortAbsolute(abs_input_port);
-    auto* new_value    = new double(value);
+    auto* new_value    = frozen_value(index);
+    *new_value         = value;
 
     block->setInputPortAbsolute(abs_input_port, new_value);
-    frozen_ports[key] = {original_ptr, new_value};
+    frozen_ports[key] = {original_ptr, index};
+    is_tape_compiled     = false;
+    is_event_graph_built = false;
 }
 
 void Scheme::unfreezePort(size_t block_index, size_t abs_input_port) {
@@ -25,16 +49,20 @@ void Scheme::unfreezePort(size_t block_index, size_t abs_input_port) {
 
     blocks[block_index]->setInputPortAbsolute(abs_input_port, it->second.original);
 
-    delete it->second.value;
+    free_frozen.push_back(it->second.value);
     frozen_ports.erase(it);
+    is_tape_compiled     = false;
+    is_event_graph_built = false;
 }
 
 void Scheme::unfreezeAllPorts() {
     for (auto& [key, frozen] : frozen_ports) {
         auto [block_index, abs_input_port] = key;
         blocks[block_index]->setInputPortAbsolute(abs_input_port, frozen.original);
-        delete frozen.value;
+        free_frozen.push_back(frozen.value);
     }
     frozen_ports.clear();
+    is_tape_compiled     = false;
+    is_event_graph_built = false;
+}
 }
-}
\ No newline at end of file
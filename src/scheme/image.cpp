@@ -0,0 +1,85 @@
+#include "nrcki/scheme.h"
+#include "image.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace nrcki {
+/**
+ * Образ схемы (см. ImageHeader): лента, параметры, текущее состояние и значения портов.
+ * Все блоки должны понижаться в ленту: образ рассчитывается без объектов блоков.
+ */
+std::vector<types::byte> Scheme::getImage() {
+    if (!is_tape_compiled)
+        compileTape();
+    if (tape.getCallCount())
+        throw std::runtime_error("getImage: scheme contains blocks without tape lowering");
+    tape.load();
+
+    const auto it            = port_memory.find(types::type_hash<Type>());
+    const auto* ports_memory = it != port_memory.end() ? reinterpret_cast<const Type*>(it->second.data()) : nullptr;
+
+    std::vector<Tape::slot> outputs;
+    outputs.reserve(absolute_output_index.size());
+    for (const auto& [type_hash, port] : absolute_output_index)
+        outputs.push_back(type_hash == types::type_hash<Type>() ? tape.slotOf(static_cast<const Type*>(port))
+                                                                : static_cast<Tape::slot>(-1));
+
+    ImageHeader header;
+    std::memcpy(header.magic, ImageHeader::signature, sizeof header.magic);
+    header.format           = ImageHeader::version;
+    header.instruction_size = sizeof(Tape::Instruction);
+    header.real_size        = sizeof(Type);
+    header.time             = time;
+    header.dt               = dt;
+    header.dt_count         = dt_count;
+
+    size bytes       = sizeof header;
+    const auto place = [&](ImageHeader::Section& section, const size count, const size element) {
+        section = {(bytes + ImageHeader::alignment - 1) / ImageHeader::alignment * ImageHeader::alignment, count};
+        bytes   = section.offset + count * element;
+    };
+    place(header.code, tape.getCode().size(), sizeof(Tape::Instruction));
+    place(header.operands, tape.getOperands().size(), sizeof(Tape::slot));
+    place(header.params, tape.getParams().size(), sizeof(Type));
+    place(header.state, tape.getState().size(), sizeof(Type));
+    place(header.memory, tape.getSlotCount(), sizeof(Type));
+    place(header.inputs, input_buffer.size(), sizeof(double));
+    place(header.outputs, outputs.size(), sizeof(Tape::slot));
+    header.image_size = bytes;
+
+    std::vector<byte> image(bytes, 0);
+    std::memcpy(image.data(), &header, sizeof header);
+
+    auto* code = reinterpret_cast<Tape::Instruction*>(image.data() + header.code.offset);
+    for (const auto& ins : tape.getCode()) {
+        *code       = ins;
+        code->block = nullptr; // Адреса блоков не переносятся
+        ++code;
+    }
+
+    const auto copy = [&](const ImageHeader::Section& section, const void* data, const size element) {
+        if (section.count)
+            std::memcpy(image.data() + section.offset, data, section.count * element);
+    };
+    copy(header.operands, tape.getOperands().data(), sizeof(Tape::slot));
+    copy(header.params, tape.getParams().data(), sizeof(Type));
+    copy(header.state, tape.getState().data(), sizeof(Type));
+    copy(header.memory, ports_memory, sizeof(Type));
+    copy(header.inputs, input_buffer.data(), sizeof(double));
+    copy(header.outputs, outputs.data(), sizeof(Tape::slot));
+    return image;
+}
+
+/// Запись образа схемы в файл (для SchemeImage)
+void Scheme::saveImage(const std::string& path) {
+    const auto image = getImage();
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file)
+        throw std::runtime_error("saveImage: cannot open " + path);
+    file.write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(image.size()));
+    if (!file)
+        throw std::runtime_error("saveImage: cannot write " + path);
+}
+}
\ No newline at end of file
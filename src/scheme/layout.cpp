@@ -0,0 +1,140 @@
+#include "nrcki/scheme.h"
+
+#include <cstdint>
+#include <unordered_set>
+
+namespace nrcki {
+/**
+ * Раскладка памяти портов по графу расчёта: выходы каждого блока размещаются непосредственно
+ * перед выходами его первого читателя (обход в глубину от конечных блоков в порядке расчёта;
+ * конечный - блок, который не читается блоками, рассчитываемыми после него).
+ * Цепочки и ветви схемы занимают непрерывные участки, поэтому чтения входов блока попадают
+ * в соседние строки кэша с его выходами, даже если порядок расчёта чередует независимые ветви.
+ * Относительные индексы портов меняются, абсолютные - нет.
+ */
+void Scheme::layout_execution_order() {
+    if (compute_sorted_blocks.empty())
+        return;
+
+    std::unordered_map<const Block*, size> block_index;
+    for (size i = 0; i < blocks.size(); ++i)
+        block_index[blocks[i].get()] = i;
+
+    std::vector position(blocks.size(), static_cast<size>(-1)); // Позиция в порядке расчёта
+    for (size k = 0; k < compute_sorted_blocks.size(); ++k)
+        position[block_index[compute_sorted_blocks[k]]] = k;
+
+    std::vector<char> has_reader(blocks.size(), 0);
+    std::vector<std::vector<size>> producers(blocks.size()); // Блок -> блоки, чьи выходы он читает (по порядку входов)
+    for (size i = 0; i < blocks.size(); ++i) {
+        const auto add_producer = [&](void* port) {
+            if (const auto* info = ports_info.find(port)) {
+                const auto producer = info->block_index;
+                producers[i].push_back(producer);
+                if (position[i] != static_cast<size>(-1) && position[producer] < position[i])
+                    has_reader[producer] = 1;
+            }
+            return port;
+        };
+
+        size input_count = 0;
+        for (const auto [type_hash, count] : blocks[i]->inputs())
+            input_count += count;
+        for (size j = 0; j < input_count; ++j)
+            add_producer(blocks[i]->getInputPortAbsolute(j));
+        blocks[i]->visitImplicitInputs(add_producer);
+    }
+
+    std::vector<char> placed(blocks.size(), 0);
+    std::vector<Block*> order;
+    order.reserve(blocks.size());
+    const auto place = [&](const size root) { // Обход в глубину без рекурсии: сначала поставщики, затем блок
+        if (placed[root])
+            return;
+        placed[root] = 1;
+        std::vector<std::pair<size, size>> stack{{root, 0}}; // [блок, следующий поставщик]
+        while (!stack.empty()) {
+            const auto [index, next] = stack.back();
+            if (next < producers[index].size()) {
+                ++stack.back().second;
+                if (const auto producer = producers[index][next]; !placed[producer]) {
+                    placed[producer] = 1;
+                    stack.emplace_back(producer, 0);
+                }
+            }
+            else {
+                order.push_back(blocks[index].get());
+                stack.pop_back();
+            }
+        }
+    };
+
+    for (const auto block : compute_sorted_blocks)
+        if (!has_reader[block_index[block]])
+            place(block_index[block]);
+
+    relayout_memory(order);
+}
+
+/**
+ * Включение раскладки памяти портов по графу расчёта (см. layout_execution_order), по умолчанию выключена:
+ * выходы размещаются в порядке добавления блоков. Относительные индексы портов и порядок значений getDoubles()
+ * следуют раскладке, при выключении восстанавливается порядок добавления.
+ * При расчёте по компонентам память размещается по компонентам, раскладка действует после partition(false).
+ * @param enable включить/выключить
+ */
+void Scheme::layoutMemory(const bool enable) {
+    is_graph_layout = enable;
+    if (is_partitioned || compute_sorted_blocks.empty())
+        return;
+    if (enable)
+        layout_execution_order();
+    else
+        relayout_memory({});
+}
+
+/// Метрики локальности текущей раскладки; строка кэша - 64 байта
+Scheme::LayoutMetrics Scheme::getLayoutMetrics() const {
+    constexpr std::uintptr_t line_size = 64;
+
+    LayoutMetrics metrics;
+    std::unordered_set<std::uintptr_t> lines;
+    auto previous = static_cast<std::uintptr_t>(-1);
+    const auto access = [&](const void* port) {
+        const auto line = reinterpret_cast<std::uintptr_t>(port) / line_size;
+        metrics.line_switches += line != previous;
+        previous = line;
+        lines.insert(line);
+        ++metrics.accesses;
+    };
+
+    double distance = 0;
+    size inputs     = 0;
+    for (const auto block : compute_sorted_blocks) {
+        const auto& outputs = block->getOutputPortsAbsolute();
+
+        size input_count = 0;
+        for (const auto [type_hash, count] : block->inputs())
+            input_count += count;
+        for (size j = 0; j < input_count; ++j) {
+            const auto port = block->getInputPortAbsolute(j);
+            if (!ports_info.contains(port))
+                continue; // Не подключён или заморожен
+            access(port);
+            if (!outputs.empty()) {
+                const auto from = reinterpret_cast<std::uintptr_t>(port);
+                const auto to   = reinterpret_cast<std::uintptr_t>(outputs.front());
+                distance += static_cast<double>(from > to ? from - to : to - from);
+                ++inputs;
+            }
+        }
+
+        for (const auto port : outputs)
+            access(port);
+    }
+
+    metrics.lines          = lines.size();
+    metrics.input_distance = inputs ? distance / static_cast<double>(inputs) : 0;
+    return metrics;
+}
+}
\ No newline at end of file
@@ -0,0 +1,161 @@
+#include "nrcki/scheme.h"
+
+#include <algorithm>
+#include <barrier>
+
+namespace nrcki {
+/**
+ * Разбиение порядка расчёта на уровни (волновые фронты).
+ * Блок попадает на уровень выше всех блоков, чьи новые выходы он читает (прямые связи),
+ * и выше всех блоков, чьи старые выходы он перезаписывает (связи, разорванные при сортировке).
+ * Блоки одного уровня не зависят друг от друга, поэтому расчёт по уровням совпадает с compute().
+ * Неявные входы блоков (внутренние сигналы) учитываются наравне со связями.
+ */
+void Scheme::compute_levels_order() {
+    const size n = compute_sorted_blocks.size();
+
+    std::unordered_map<const Block*, size> block_index;
+    for (size i = 0; i < blocks.size(); ++i)
+        block_index[blocks[i].get()] = i;
+
+    std::vector position(blocks.size(), static_cast<size>(-1));
+    for (size i = 0; i < n; ++i)
+        position[block_index[compute_sorted_blocks[i]]] = i;
+
+    // Ограничения: before[k] - позиции блоков, которые должны завершиться до блока k
+    auto& before = compute_dependencies;
+    before.assign(n, {});
+    const auto add_link = [&](const size from, const size to) {
+        const auto u = position[from], v = position[to];
+        if (u == static_cast<size>(-1) || v == static_cast<size>(-1) || u == v)
+            return;
+        u < v ? before[v].push_back(u) : before[u].push_back(v);
+    };
+
+    for (const auto& [from, consumers] : direct_graph)
+        for (const auto to : consumers)
+            add_link(from, to);
+
+    // Неявные входы (внутренние сигналы) - те же связи, но не отражённые в direct_graph
+    for (size k = 0; k < n; ++k)
+        compute_sorted_blocks[k]->visitImplicitInputs([&](void* port) {
+            if (const auto* info = ports_info.find(port))
+                add_link(info->block_index, block_index[compute_sorted_blocks[k]]);
+            return port;
+        });
+
+    std::vector<size> level(n, 0);
+    size levels_count = n ? 1 : 0;
+    for (size k = 0; k < n; ++k) {
+        for (const auto j : before[k])
+            level[k] = std::max(level[k], level[j] + 1);
+        levels_count = std::max(levels_count, level[k] + 1);
+    }
+
+    compute_levels.assign(levels_count, {});
+    for (size k = 0; k < n; ++k)
+        compute_levels[level[k]].push_back(compute_sorted_blocks[k]);
+
+    build_stages();
+    is_task_graph_built  = false;
+    is_event_graph_built = false;
+}
+
+/// Объединение соседних мелких уровней в последовательные этапы
+void Scheme::build_stages() {
+    level_blocks.clear();
+    stages.clear();
+
+    for (const auto& level : compute_levels) {
+        const bool is_parallel = level.size() >= min_parallel_level;
+        if (stages.empty() || is_parallel || stages.back().is_parallel)
+            stages.push_back({level_blocks.size(), level_blocks.size(), is_parallel});
+        level_blocks.insert(level_blocks.end(), level.begin(), level.end());
+        stages.back().end = level_blocks.size();
+    }
+}
+
+/**
+ * Задание числа потоков параллельного расчёта.
+ * @param count число потоков (включая вызывающий), 0 - число аппаратных потоков
+ * @param min_level_size минимальный размер уровня, рассчитываемого параллельно
+ */
+void Scheme::setThreads(size count, const size min_level_size) {
+    if (count == 0)
+        count = std::max(1u, std::thread::hardware_concurrency());
+
+    pool               = count > 1 ? std::make_unique<WorkerPool>(count) : nullptr;
+    min_parallel_level = std::max<size>(min_level_size, 1);
+    build_stages();
+    if (is_partitioned)
+        group_components();
+}
+
+/**
+ * Параллельный расчёт по уровням на постоянном пуле потоков.
+ * Крупные уровни делятся между потоками поровну, мелкие рассчитываются одним потоком,
+ * этапы разделяются барьером. Без пула, крупных уровней или при разных периодах дискретизации - обычный compute().
+ * @param steps количество шагов интегрирования
+ */
+void Scheme::computeParallel(const uint64_t steps) {
+    if (!pool || is_multirate || std::ranges::none_of(stages, &Stage::is_parallel)) {
+        compute(steps);
+        return;
+    }
+    if (steps == 0)
+        return;
+
+    const size workers = pool->getCount();
+    size stage         = 0;
+    uint64_t step      = 0;
+
+    time += dt;
+    std::barrier sync(static_cast<std::ptrdiff_t>(workers), [&]() noexcept {
+        if (++stage == stages.size()) {
+            stage = 0;
+            if (++step < steps)
+                time += dt;
+        }
+    });
+
+    pool->run([&](const size worker) {
+        for (uint64_t i = 0; i < steps; ++i)
+            for (const auto& [begin, end, is_parallel] : stages) {
+                if (is_parallel) {
+                    const size count = end - begin;
+                    const size first = begin + count * worker / workers;
+                    const size last  = begin + count * (worker + 1) / workers;
+                    for (size k = first; k < last; ++k)
+                        level_blocks[k]->compute();
+                }
+                else if (worker == 0)
+                    for (size k = begin; k < end; ++k)
+                        level_blocks[k]->compute();
+
+                sync.arrive_and_wait();
+            }
+    });
+    dt_count += steps;
+}
+
+/**
+ * Расчёт по графу задач на пуле потоков с перехватом работы.
+ * В отличие от computeParallel() шаг не делится на уровни: задача запускается,
+ * как только рассчитаны все её зависимости. Без пула или при разных периодах дискретизации - обычный compute().
+ * @param steps количество шагов интегрирования
+ */
+void Scheme::computeTasks(const uint64_t steps) {
+    if (!pool || is_multirate) {
+        compute(steps);
+        return;
+    }
+
+    if (!is_task_graph_built) {
+        task_graph.build(compute_sorted_blocks, compute_dependencies);
+        is_task_graph_built = true;
+    }
+
+    task_graph.execute(*pool, steps, [this] { time += dt; });
+    dt_count += steps;
+}
+}
\ No newline at end of file
@@ -0,0 +1,186 @@
+#include "nrcki/scheme.h"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+namespace nrcki {
+/**
+ * Перераспределение памяти портов: выходы блоков order размещаются первыми и подряд.
+ * Значения портов переносятся, входы блоков, замороженные порты и неявные входы
+ * перенаправляются на новые адреса, индексы портов перестраиваются.
+ * @param order блоки в порядке размещения
+ */
+void Scheme::relayout_memory(const std::vector<Block*>& order) {
+    // Старые слоты выходов блоков: block -> type_hash -> первый слот
+    std::vector<std::unordered_map<size, size>> old_slots(blocks.size());
+    for (size i = 0; i < blocks.size(); ++i)
+        for (const auto [type_hash, count] : blocks[i]->outputs())
+            if (count)
+                old_slots[i][type_hash] = (static_cast<byte*>(blocks[i]->getOutputPortRelative(type_hash, 0)) -
+                                           port_memory[type_hash].data()) / types::type_size(type_hash);
+
+    memory_layout = order;
+    assign_port_memory();
+
+    // Соответствие слотов: type_hash -> старый слот -> новый слот
+    std::unordered_map<size, std::vector<size>> remap;
+    for (const auto& [type_hash, count] : total_outputs)
+        remap[type_hash].resize(count);
+    for (size i = 0; i < blocks.size(); ++i)
+        for (const auto [type_hash, count] : blocks[i]->outputs())
+            if (count) {
+                const auto type_size = types::type_size(type_hash);
+                const auto first     = (static_cast<byte*>(blocks[i]->getOutputPortRelative(type_hash, 0)) -
+                                        port_memory[type_hash].data()) / type_size;
+                for (size j = 0; j < count; ++j)
+                    remap[type_hash][old_slots[i][type_hash] + j] = first + j;
+            }
+
+    const auto move_slots = [&](auto& memory) {
+        for (auto& [type_hash, bytes] : memory) {
+            const auto type_size = types::type_size(type_hash);
+            const auto& slots    = remap[type_hash];
+            const std::vector<byte> old_bytes(bytes.begin(), bytes.end());
+            for (size slot = 0; slot < slots.size(); ++slot)
+                std::memcpy(bytes.data() + slots[slot] * type_size, old_bytes.data() + slot * type_size, type_size);
+        }
+    };
+    move_slots(port_memory);
+    move_slots(initial_memory); // Начальный образ (см. reset) переразмещается вместе с памятью портов
+
+    const auto translate = [&](void* port) -> void* {
+        for (auto& [type_hash, bytes] : port_memory) {
+            auto* data = bytes.data();
+            if (port < data || port >= data + bytes.size())
+                continue;
+            const auto type_size = types::type_size(type_hash);
+            return data + remap[type_hash][(static_cast<byte*>(port) - data) / type_size] * type_size;
+        }
+        return port;
+    };
+
+    for (const auto& block : blocks) {
+        size input_count = 0;
+        for (const auto [type_hash, count] : block->inputs())
+            input_count += count;
+        for (size j = 0; j < input_count; ++j)
+            if (auto* port = block->getInputPortAbsolute(j))
+                block->setInputPortAbsolute(j, translate(port));
+        block->visitImplicitInputs(translate);
+    }
+
+    for (auto& [key, frozen] : frozen_ports)
+        frozen.original = translate(frozen.original);
+
+    for (const auto& [type_hash, slots] : remap)
+        ports_info.permute(type_hash, slots);
+
+    init_indices();
+    is_tape_compiled     = false;
+    is_event_graph_built = false;
+}
+
+/**
+ * Разбиение порядка расчёта на компоненты слабой связности.
+ * Каждая компонента получает собственный порядок расчёта (подпоследовательность compute_sorted_blocks),
+ * собственный контекст со временем и непрерывный участок памяти портов.
+ */
+void Scheme::build_components() {
+    const size n = compute_sorted_blocks.size();
+
+    std::vector<size> parent(n);
+    std::iota(parent.begin(), parent.end(), 0);
+    const auto find = [&](size k) {
+        while (parent[k] != k)
+            k = parent[k] = parent[parent[k]];
+        return k;
+    };
+
+    for (size k = 0; k < n; ++k)
+        for (const auto j : compute_dependencies[k])
+            parent[find(j)] = find(k);
+
+    components.clear();
+    std::unordered_map<size, size> component_of; // Корень -> компонента
+    for (size k = 0; k < n; ++k) {
+        const auto [it, inserted] = component_of.try_emplace(find(k), components.size());
+        if (inserted)
+            components.push_back({{}, std::make_unique<PartitionContext>(*this)});
+        components[it->second].order.push_back(compute_sorted_blocks[k]);
+    }
+
+    std::vector<Block*> layout;
+    for (const auto& component : components)
+        layout.insert(layout.end(), component.order.begin(), component.order.end());
+    relayout_memory(layout);
+
+    group_components();
+}
+
+/// Распределение компонент по потокам пула: крупные компоненты первыми, в наименее загруженный поток
+void Scheme::group_components() {
+    const size workers = pool ? pool->getCount() : 1;
+    component_groups.assign(workers, {});
+
+    std::vector<size> indices(components.size());
+    std::iota(indices.begin(), indices.end(), 0);
+    std::ranges::stable_sort(indices, std::greater{}, [&](const size i) { return components[i].order.size(); });
+
+    std::vector<size> load(workers, 0);
+    for (const auto index : indices) {
+        const auto worker = std::ranges::min_element(load) - load.begin();
+        component_groups[worker].push_back(index);
+        load[worker] += components[index].order.size();
+    }
+}
+
+/**
+ * Включение расчёта по компонентам связности.
+ * Независимые подсистемы рассчитываются compute() каждая в своём потоке пула (см. setThreads)
+ * сразу на все шаги, без синхронизации между шагами. Периоды дискретизации блоков соблюдаются.
+ * Память портов переразмещается по компонентам (при выключении - по графу расчёта, если включено layoutMemory()),
+ * поэтому относительные индексы портов меняются.
+ * @param enable включить/выключить
+ */
+void Scheme::partition(const bool enable) {
+    is_partitioned = enable;
+    if (enable)
+        build_components();
+    else {
+        components.clear();
+        component_groups.clear();
+        if (is_graph_layout)
+            layout_execution_order();
+    }
+}
+
+void Scheme::compute_components(const uint64_t steps) {
+    for (const auto& [order, context] : components) {
+        context->setTime(time);
+        for (const auto block : order)
+            block->setContext(*context);
+    }
+
+    pool->run([&](const size worker) {
+        if (worker >= component_groups.size())
+            return;
+        for (const auto index : component_groups[worker]) {
+            const auto& [order, context] = components[index];
+            for (uint64_t i = 0; i < steps; ++i) {
+                context->advance(dt);
+                for (const auto block : order)
+                    if (block->isDue(dt_count + i))
+                        block->compute();
+            }
+        }
+    });
+
+    for (const auto& [order, context] : components)
+        for (const auto block : order)
+            block->setContext(*this);
+
+    time     += static_cast<types::time>(steps) * dt;
+    dt_count += steps;
+}
+}
\ No newline at end of file
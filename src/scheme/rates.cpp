@@ -0,0 +1,68 @@
+#include "nrcki/scheme.h"
+
+#include <numeric>
+#include <stdexcept>
+
+namespace nrcki {
+/**
+ * Задание периода дискретизации блока.
+ * Блок рассчитывается на шагах step (с нуля), для которых step % period == offset,
+ * и интегрирует с шагом period * dt. Между расчётами его выходы удерживаются (экстраполятор нулевого порядка),
+ * быстрые выходы читаются медленным блоком в момент его расчёта.
+ * Многочастотную схему рассчитывает только compute(): остальные движки (лента, уровни, граф задач,
+ * событийный расчёт, пропуск установившегося режима) переходят на compute(), а построенные по ленте
+ * пакет, чувствительность и образ схемы недоступны (исключение compileTape()).
+ * @param block_index индекс блока
+ * @param period период в шагах интегрирования схемы (1 - каждый шаг)
+ * @param offset смещение первого расчёта, меньше period (для разнесения медленных блоков по шагам)
+ */
+void Scheme::setSamplePeriod(const size block_index, const size period, const size offset) {
+    if (block_index >= blocks.size())
+        throw std::runtime_error("setSamplePeriod: block index out of range");
+    if (period == 0 || offset >= period)
+        throw std::runtime_error("setSamplePeriod: period must be positive and offset less than period");
+
+    blocks[block_index]->setPeriod(period, offset);
+
+    is_multirate = false;
+    for (const auto& block : blocks)
+        is_multirate = is_multirate || block->getPeriod() != 1;
+
+    build_rate_schedule();
+    is_tape_compiled     = false;
+    is_event_graph_built = false;
+}
+
+/// Расписание расчёта на гиперпериод: фаза -> блоки, рассчитываемые на ней (в порядке расчёта)
+void Scheme::build_rate_schedule() {
+    rate_schedule.clear();
+    if (!is_multirate)
+        return;
+
+    size hyperperiod = 1;
+    for (const auto block : compute_sorted_blocks) {
+        hyperperiod = std::lcm(hyperperiod, block->getPeriod());
+        if (hyperperiod > max_hyperperiod)
+            return; // Слишком длинный гиперпериод: проверка isDue() на каждом шаге
+    }
+
+    rate_schedule.assign(hyperperiod, {});
+    for (size phase = 0; phase < hyperperiod; ++phase)
+        for (const auto block : compute_sorted_blocks)
+            if (block->isDue(phase))
+                rate_schedule[phase].push_back(block);
+}
+
+void Scheme::compute_multirate(const uint64_t steps) {
+    for (uint64_t i = 0; i < steps; ++i, ++dt_count) {
+        time += dt;
+        if (!rate_schedule.empty())
+            for (const auto block : rate_schedule[dt_count % rate_schedule.size()])
+                block->compute();
+        else
+            for (const auto block : compute_sorted_blocks)
+                if (block->isDue(dt_count))
+                    block->compute();
+    }
+}
+}
\ No newline at end of file
@@ -8,7 +8,10 @@
 #include <algo/kahn.hpp>
 
 #include <algorithm>
-#include <set>
+#include <cmath>
+#include <map>
+#include <stdexcept>
+#include <unordered_set>
 
 namespace nrcki {
 void Scheme::compute_calculation_order() {
@@ -19,6 +22,7 @@ void Scheme::compute_calculation_order() {
             prioritized_breakers.push_back(i);
 
     time = 0;
+    initial_memory.clear();
     sorted_blocks.clear();
     active_sorted_blocks.clear();
     compute_sorted_blocks.clear();
@@ -38,6 +42,16 @@ void Scheme::compute_calculation_order() {
 
     std::ranges::reverse(compute_sorted_blocks); // обратный порядок блоков для неявного вычисления
     compute_sorted_blocks.insert(compute_sorted_blocks.end(), explicit_blocks.begin(), explicit_blocks.end());
+    compute_levels_order();
+    build_rate_schedule();
+    if (is_partitioned)
+        build_components();
+    else if (is_graph_layout)
+        layout_execution_order();
+
+    bind_inputs(execution_order());
+    capture_initial_state();
+    is_tape_compiled = false;
 }
 
 void Scheme::init_indices() {
@@ -47,37 +61,33 @@ void Scheme::init_indices() {
     relative_input_index.clear();
     absolute_input_index.clear();
     absolute_output_index.clear();
-    relative_output_index.clear();
 
-    std::set<size> sorted_type_hashes;
     for (auto& [type_hash, bytes] : port_memory) {
-        const size count             = total_outputs[type_hash];
-        const size type_size         = types::type_size(type_hash);
-        auto& relative_output_points = relative_output_index[type_hash];
-        byte* data                   = bytes.data();
-        for (size i = 0; i < count; ++i) {
-            relative_output_points.emplace_back(data + i * type_size);
-            ports_info[data + i * type_size].relative_index = relative_output_points.size() - 1;
-        }
-        sorted_type_hashes.insert(type_hash);
+        const size count     = total_outputs[type_hash];
+        const size type_size = types::type_size(type_hash);
+        byte* data           = bytes.data();
+        for (size i = 0; i < count; ++i)
+            ports_info[data + i * type_size].relative_index = i;
     }
 
-    for (size i = 0; i < blocks_count; ++i) {
-        int abs_input_index = -1;
-        auto inputs         = blocks[i]->inputs();
-        auto outputs        = blocks[i]->outputs();
-        for (const auto& type_hash : sorted_type_hashes) {
-            const auto input_count      = inputs[type_hash];
+    for (size i = 0; i < blocks.size(); ++i) {
+        const auto& outputs = blocks[i]->getOutputPortsAbsolute();
+        for (const auto port_point : outputs)
+            ports_info[port_point].block_index = i;
+        if (i >= blocks_count)
+            continue; // Преобразования типов, вставленные схемой, не индексируются
+
+        size abs_input_index = 0;
+        const auto inputs    = blocks[i]->inputs();
+        for (const auto& [type_hash, input_count] : std::map(inputs.begin(), inputs.end())) {
             auto& relative_input_points = relative_input_index[type_hash];
             for (size j = 0; j < input_count; ++j) {
-                absolute_input_index.emplace_back(i, ++abs_input_index);
+                absolute_input_index.emplace_back(i, abs_input_index++);
                 relative_input_points.emplace_back(i, j);
             }
-            for (auto port_point : blocks[i]->getOutputPortsAbsolute()) {
-                absolute_output_index.emplace_back(type_hash, port_point);
-                ports_info[port_point].block_index = i;
-            }
         }
+        for (size j = 0; j < outputs.size(); ++j)
+            absolute_output_index.emplace_back(blocks[i]->getOutputType(j), outputs[j]);
     }
 }
 
@@ -87,11 +97,25 @@ void Scheme::allocate_memory() {
         for (const auto [type_hash, count] : block->outputs())
             total_outputs[type_hash] += count;
 
-    for (const auto& [type_hash, count] : total_outputs)
-        port_memory[type_hash].resize(count * types::type_size(type_hash));
+    const auto previous = std::move(arena); // Таблицы входов блоков читаются из прежней арены (bind_inputs)
+    layout_arena();
+    place_arena();
+    assign_port_memory();
+    build_signals();
+    init_indices();
+    bind_inputs(execution_order());
+}
+
+/// Распределение памяти портов по блокам: сначала memory_layout, затем остальные в порядке добавления
+void Scheme::assign_port_memory() {
+    const std::unordered_set<const Block*> placed(memory_layout.begin(), memory_layout.end());
+    std::vector<Block*> order(memory_layout.begin(), memory_layout.end());
+    for (const auto& block : blocks)
+        if (!placed.contains(block.get()))
+            order.push_back(block.get());
 
     std::unordered_map<size, size> offsets;
-    for (const auto& block : blocks) {
+    for (const auto block : order) {
         std::unordered_map<size, void*> block_memory;
         for (const auto& [type_hash, count] : block->outputs()) {
             block_memory[type_hash] = port_memory[type_hash].data() + offsets[type_hash];
@@ -100,12 +124,18 @@ void Scheme::allocate_memory() {
 
         block->outputs(block_memory);
     }
-
-    build_signals();
-    init_indices();
 }
 
 void Scheme::compute(const uint64_t steps) {
+    if (is_partitioned && pool && components.size() > 1) {
+        compute_components(steps);
+        return;
+    }
+    if (is_multirate) {
+        compute_multirate(steps);
+        return;
+    }
+
     for (size i = 0; i < steps; ++i) {
         time += dt;
         for (const auto block : compute_sorted_blocks)
@@ -119,12 +149,79 @@ void Scheme::computeSync(const uint64_t steps) {
     while (time < Time) {
         time += dt;
         for (const auto block : compute_sorted_blocks)
-            block->compute();
+            if (block->isDue(dt_count))
+                block->compute();
         ++dt_count;
     }
 }
 
+/**
+ * Задание шагов расчёта схемы.
+ * Дискретные коэффициенты блоков (динамических звеньев, фильтров) пересчитываются под новый шаг,
+ * поэтому шаг можно задавать как до, так и после добавления блоков.
+ * @param sync шаг синхронизации [сек] (computeSync)
+ * @param delta_time шаг интегрирования [сек], округляется до основания времени (1 мкс);
+ * шаг в секундах для коэффициентов блоков берётся от округлённого шага, чтобы совпадать с ходом времени
+ */
+void Scheme::setSteps(const double sync, const double delta_time) {
+    const auto step = static_cast<types::time>(std::llround(delta_time * sec));
+    if (step <= 0)
+        throw std::runtime_error("setSteps: integration step must be positive");
+
+    sync_step = sync * Context::sec;
+    delta     = step;
+    delta_sec = static_cast<Type>(step) / sec;
+    for (const auto& block : blocks)
+        block->discretize();
+    is_tape_compiled = false;
+}
+
+/**
+ * Задание метода дискретизации линейных динамических звеньев (Integrator, Inertial, InertialDifferential, Oscillatory).
+ * Коэффициенты пересчитываются сразу, стоимость шага не меняется.
+ * ZeroOrderHold и Tustin устойчивы при любом шаге, что позволяет увеличивать шаг интегрирования.
+ * @param value метод дискретизации
+ */
+void Scheme::setDiscretization(const Discretization value) {
+    method = value;
+    for (const auto& block : blocks)
+        block->discretize();
+    is_tape_compiled = false;
+}
+
+/**
+ * Режим логических портов: логические блоки, сравнения, импульсы, задержки и триггеры
+ * хранят выходы и читают входы как bool (1 байт вместо 8), что сокращает память
+ * логических схем защит. На связях с вещественными портами схема вставляет преобразования типа,
+ * абсолютные индексы портов при этом не меняются. Блоки с вещественными параметрами на входах
+ * (импульсы и задержки с переменной длительностью, ключи) остаются вещественными.
+ * Задаётся до добавления блоков.
+ * @param enable true - порты bool, false - вещественные (по умолчанию)
+ */
+void Scheme::setLogicPorts(const bool enable) {
+    if (!blocks.empty())
+        throw std::runtime_error("setLogicPorts: port type must be set before adding blocks");
+    logic_ports = enable;
+}
+
+/**
+ * Точность вещественных портов и состояния блоков. В режиме Single семейства блоков, допускающие float,
+ * - источники, операторы, нелинейные, динамические звенья, кусочно-линейная интерполяция, ключи,
+ * а также логические блоки и сравнения (если порты не bool) - рассчитываются во float:
+ * вдвое меньше памяти портов. Сигналы (внешние входы и выходы), импульсы и задержки с переменной
+ * длительностью остаются double, на связях схема вставляет преобразования типа.
+ * Лента инструкций понижает только блоки double, блоки float рассчитываются вызовом.
+ * Задаётся до добавления блоков.
+ * @param value точность (по умолчанию Double)
+ */
+void Scheme::setPrecision(const Precision value) {
+    if (!blocks.empty())
+        throw std::runtime_error("setPrecision: precision must be set before adding blocks");
+    precision = value;
+}
+
 std::vector<uint8_t> Scheme::getDoubles() {
-    return port_memory[types::type_hash<double>()];
+    const auto bytes = port_memory[types::type_hash<double>()];
+    return {bytes.begin(), bytes.end()};
 }
 }
\ No newline at end of file
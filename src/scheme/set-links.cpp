@@ -1,38 +1,126 @@
 #include "nrcki/scheme.h"
 
+#include "blocks/signals/cast.hpp"
+
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+#include <tuple>
+
 namespace nrcki {
+namespace {
+/// Блок преобразования выхода типа From во вход типа to (nullptr, если преобразования нет)
+template <typename From>
+std::unique_ptr<Block> make_cast_from(const Context& context, const types::size to) {
+    if (to == types::type_hash<double>())
+        return std::make_unique<Cast<From, double>>(context);
+    if (to == types::type_hash<float>())
+        return std::make_unique<Cast<From, float>>(context);
+    if (to == types::type_hash<bool>())
+        return std::make_unique<Cast<From, bool>>(context);
+    return nullptr;
+}
+}
+
+/// Блок преобразования выхода типа from во вход типа to (double, float, bool)
+std::unique_ptr<Block> Scheme::make_cast(const size from, const size to) const {
+    std::unique_ptr<Block> block;
+    if (from == types::type_hash<double>())
+        block = make_cast_from<double>(*this, to);
+    else if (from == types::type_hash<float>())
+        block = make_cast_from<float>(*this, to);
+    else if (from == types::type_hash<bool>())
+        block = make_cast_from<bool>(*this, to);
+
+    if (!block)
+        throw std::runtime_error("setLinks: no conversion from " + types::type_name(from) + " to " + types::type_name(to));
+    return block;
+}
+
+/**
+ * Связывание абсолютных выходов и входов блоков (память портов уже выделена).
+ * Если типы портов связи различаются (вещественный выход - логический вход и наоборот),
+ * выход читается через блок преобразования, общий для всех входов этого типа
+ * (в том числе связанных при повторном задании связей: вставленный блок используется повторно).
+ * Вставленные блоки добавляются в конец схемы и не входят в blocks_count:
+ * абсолютные индексы портов схемы не меняются.
+ * @param connections связи [блок, абсолютный выход] -> [блок, абсолютный вход]
+ */
+void Scheme::connect(std::vector<Connection> connections) {
+    const auto count = blocks.size();
+    std::vector<Connection> cast_inputs;
+    for (auto& connection : connections) {
+        const auto from = blocks[connection.producer]->getOutputType(connection.output);
+        const auto to   = blocks[connection.consumer]->getInputType(connection.input);
+        if (from == to)
+            continue;
+
+        const auto [it, inserted] = casts.try_emplace({connection.producer, connection.output, to}, blocks.size());
+        if (inserted) {
+            blocks.push_back(make_cast(from, to));
+            cast_inputs.push_back({connection.producer, connection.output, it->second, 0});
+        }
+        connection.producer = it->second;
+        connection.output   = 0;
+    }
+
+    if (blocks.size() != count)
+        allocate_memory();
+
+    connections.insert(connections.end(), cast_inputs.begin(), cast_inputs.end());
+    for (const auto& [producer, output, consumer, input] : connections) {
+        blocks[consumer]->setInputPortAbsolute(input, blocks[producer]->getOutputPortAbsolute(output));
+        //reverse_graph[consumer].push_back(producer);
+        direct_graph[producer].push_back(consumer);
+    }
+}
+
 #define SIZE 2
 /// [0: output_port, 1: input_port]
 [[maybe_unused]] void Scheme::setAbsoluteLinks(const link n, const link* links) {
     allocate_memory();
+    std::vector<Connection> connections;
+    connections.reserve(n);
     const auto last = links + SIZE * n;
     for (auto link = links; link != last; link += SIZE) {
         const auto [block_index, port_index] = absolute_input_index[link[1]];
         const auto port_point                = absolute_output_index[link[0]].second;
-        blocks[block_index]->setInputPortAbsolute(port_index, port_point);
-        //reverse_graph[block_index].push_back(ports_info[port_point].block_index);
-        direct_graph[ports_info[port_point].block_index].push_back(block_index);
+        const auto producer                  = ports_info[port_point].block_index;
+        const auto& outputs                  = blocks[producer]->getOutputPortsAbsolute();
+        const auto output                    = std::ranges::find(outputs, port_point) - outputs.begin();
+        connections.push_back({producer, static_cast<size>(output), block_index, port_index});
     }
 
+    connect(std::move(connections));
     compute_calculation_order();
 }
 #undef SIZE
 
 #define SIZE 3
-/// [0: type_hash, 1: output_port, 2: input_port]
+/// [0: type_hash, 1: output_port, 2: input_port] (относительные индексы - среди портов типа type_hash)
 [[maybe_unused]] void Scheme::setRelativeLinks(const link n, const link* links) {
     allocate_memory();
-
+    std::vector<Connection> connections;
+    connections.reserve(n);
     const auto last = links + SIZE * n;
     for (auto link = links; link != last; link += SIZE) {
-        uint64_t type_hash                   = link[0];
-        const auto [block_index, port_index] = relative_input_index[type_hash][link[2]];
-        const auto port_point                = relative_output_index[type_hash][link[1]];
-        blocks[block_index]->setInputPortRelative(type_hash, port_index, port_point);
-        //reverse_graph[block_index].push_back(ports_info[port_point].block_index);
-        direct_graph[ports_info[port_point].block_index].push_back(block_index);
+        const size type_hash = link[0];
+        const auto inputs    = relative_input_index.find(type_hash);
+        const auto outputs   = total_outputs.find(type_hash);
+        if (inputs == relative_input_index.end() || outputs == total_outputs.end())
+            throw std::runtime_error("setRelativeLinks: no ports of the link type");
+        if (link[1] >= outputs->second || link[2] >= inputs->second.size())
+            throw std::runtime_error("setRelativeLinks: port index out of range");
+
+        const auto [block_index, port_index] = inputs->second[link[2]];
+        const auto port_point                = port_memory[type_hash].data() + link[1] * types::type_size(type_hash);
+        const auto producer                  = ports_info[port_point].block_index;
+        const auto& block_outputs            = blocks[producer]->getOutputPortsAbsolute();
+        const auto output                    = std::ranges::find(block_outputs, port_point) - block_outputs.begin();
+        connections.push_back({producer, static_cast<size>(output), block_index, port_index});
     }
 
+    connect(std::move(connections));
     compute_calculation_order();
 }
 #undef SIZE
@@ -42,31 +130,33 @@ namespace nrcki {
 [[maybe_unused]] void Scheme::setAbsoluteBlockLinks(const link n, const link* links) {
     allocate_memory();
 
+    std::vector<Connection> connections;
+    connections.reserve(n);
     const auto last = links + SIZE * n;
-    for (auto link = links; link != last; link += SIZE) {
-        blocks[link[2]]->setInputPortAbsolute(link[3], blocks[link[0]]->getOutputPortAbsolute(link[1]));
-        //reverse_graph[link[2]].push_back(link[0]);
-        direct_graph[link[0]].push_back(link[2]);
-    }
+    for (auto link = links; link != last; link += SIZE)
+        connections.push_back({link[0], link[1], link[2], link[3]});
 
+    connect(std::move(connections));
     compute_calculation_order();
 }
 #undef SIZE
 
 #define SIZE 5
-/// [0: type_hash, 1: output_block, 2: output_port, 3: input_block, 4: input_port]
+/// [0: type_hash, 1: output_block, 2: output_port, 3: input_block, 4: input_port] (порты - среди портов типа type_hash)
 [[maybe_unused]] void Scheme::setRelativeBlockLinks(const link n, const link* links) {
     allocate_memory();
-
+    std::vector<Connection> connections;
+    connections.reserve(n);
     const auto last = links + SIZE * n;
     for (auto link = links; link != last; link += SIZE) {
-        const uint64_t type_hash = link[0];
-        blocks[link[3]]->setInputPortRelative(type_hash, link[4],
-                                              blocks[link[1]]->getOutputPortRelative(type_hash, link[2]));
-        //reverse_graph[link[3]].push_back(link[1]);
-        direct_graph[link[1]].push_back(link[3]);
+        if (link[1] >= blocks_count || link[3] >= blocks_count)
+            throw std::runtime_error("setRelativeBlockLinks: block index out of range");
+        const size type_hash = link[0];
+        connections.push_back({link[1], blocks[link[1]]->getOutputIndex(type_hash, link[2]),
+                               link[3], blocks[link[3]]->getInputIndex(type_hash, link[4])});
     }
 
+    connect(std::move(connections));
     compute_calculation_order();
 }
 #undef SIZE
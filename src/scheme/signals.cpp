@@ -11,8 +11,8 @@ void Scheme::build_signals() {
             total_out += sig->getNumOutputs();
         }
 
-    input_buffer.assign(total_in, 0.0);
-    output_buffer.assign(total_out, 0.0);
+    std::ranges::fill(input_buffer, 0.0);
+    std::ranges::fill(output_buffer, 0.0);
 
     double* in_ptr  = input_buffer.data();
     double* out_ptr = output_buffer.data();
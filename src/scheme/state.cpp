@@ -0,0 +1,111 @@
+#include "nrcki/scheme.h"
+
+#include <algorithm>
+#include <cstring>
+#include <set>
+#include <stdexcept>
+
+namespace nrcki {
+/// Обход состояния схемы в фиксированном порядке: время, память портов, буферы сигналов, состояние блоков
+void Scheme::visit_state(const std::function<void(void*, size)>& visit) {
+    visit(&time, sizeof time);
+    visit(&Time, sizeof Time);
+    visit(&dt_count, sizeof dt_count);
+
+    std::set<size> type_hashes;
+    for (const auto& [type_hash, bytes] : port_memory)
+        type_hashes.insert(type_hash);
+    for (const auto type_hash : type_hashes) {
+        auto& bytes = port_memory.at(type_hash);
+        visit(bytes.data(), bytes.size());
+    }
+
+    visit(input_buffer.data(), input_buffer.size() * sizeof(double));
+    visit(output_buffer.data(), output_buffer.size() * sizeof(double));
+
+    for (const auto& block : blocks)
+        block->visitState(visit);
+}
+
+/// Образ состояния схемы сразу после построения (память портов после init() и состояние блоков)
+void Scheme::capture_initial_state() {
+    initial_memory.clear();
+    for (const auto& [type_hash, bytes] : port_memory)
+        initial_memory[type_hash].assign(bytes.begin(), bytes.end());
+    initial_state.clear();
+    for (const auto& block : blocks)
+        block->visitState([&](void* data, const size length) {
+            const auto* bytes = static_cast<const byte*>(data);
+            initial_state.insert(initial_state.end(), bytes, bytes + length);
+        });
+}
+
+/**
+ * Возврат схемы в начальное состояние (как сразу после задания связей) без перестроения:
+ * память портов и состояние блоков копируются из образа, снятого при построении,
+ * время, число шагов и буферы внешних сигналов обнуляются.
+ * Настройки (шаг, периоды дискретизации, замороженные порты, потоки) сохраняются.
+ */
+void Scheme::reset() {
+    for (auto& [type_hash, bytes] : port_memory)
+        if (const auto it = initial_memory.find(type_hash); it != initial_memory.end())
+            std::memcpy(bytes.data(), it->second.data(), bytes.size());
+
+    const byte* data = initial_state.data();
+    for (const auto& block : blocks)
+        block->visitState([&](void* target, const size length) {
+            std::memcpy(target, data, length);
+            data += length;
+        });
+
+    std::ranges::fill(input_buffer, 0.0);
+    std::ranges::fill(output_buffer, 0.0);
+    time     = 0;
+    Time     = 0;
+    dt_count = 0;
+
+    event_step = static_cast<size>(-1);
+}
+
+/// Размер снимка состояния схемы [байт]
+Scheme::size Scheme::getStateSize() {
+    size bytes = 0;
+    visit_state([&](void*, const size length) { bytes += length; });
+    return bytes;
+}
+
+/**
+ * Снимок полного состояния схемы в непрерывный буфер:
+ * время и число шагов, память всех портов, буферы внешних сигналов и внутреннее состояние блоков
+ * (предыдущие значения входов, таймеры задержек и импульсов, состояние динамических звеньев).
+ * Параметры, связи и замороженные порты в снимок не входят.
+ */
+std::vector<Scheme::byte> Scheme::saveState() {
+    std::vector<byte> state;
+    state.reserve(getStateSize());
+    visit_state([&](void* data, const size length) {
+        const auto* bytes = static_cast<const byte*>(data);
+        state.insert(state.end(), bytes, bytes + length);
+    });
+    return state;
+}
+
+/**
+ * Восстановление состояния схемы из снимка saveState() без перестроения схемы.
+ * Позволяет многократно продолжать расчёт из одной точки (ветвление сценариев "что если").
+ * Снимок должен быть получен от этой же схемы (или схемы той же структуры).
+ * @param state снимок состояния
+ */
+void Scheme::restoreState(const std::vector<byte>& state) {
+    if (state.size() != getStateSize())
+        throw std::runtime_error("restoreState: state size does not match the scheme");
+
+    const byte* data = state.data();
+    visit_state([&](void* target, const size length) {
+        std::memcpy(target, data, length);
+        data += length;
+    });
+
+    event_step = static_cast<size>(-1); // Флаги и календарь событийного расчёта не соответствуют восстановленному состоянию
+}
+}
\ No newline at end of file
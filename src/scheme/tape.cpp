@@ -0,0 +1,102 @@
+#include "nrcki/scheme.h"
+
+#include <stdexcept>
+
+namespace nrcki {
+/**
+ * Понижает порядок расчёта (compute_sorted_blocks) в ленту инструкций.
+ * Блоки, поддерживающие понижение, становятся инструкциями с индексами слотов
+ * вещественной памяти портов и встроенными параметрами, остальные - вызовами compute().
+ * Многочастотные схемы в ленту не понижаются (см. setSamplePeriod).
+ */
+void Scheme::compileTape() {
+    if (is_multirate)
+        throw std::runtime_error("compileTape: multi-rate schemes are not supported");
+
+    const auto hash = types::type_hash<Type>();
+    if (const auto it = port_memory.find(hash); it != port_memory.end())
+        tape.clear(reinterpret_cast<const Type*>(it->second.data()), total_outputs[hash]);
+    else
+        tape.clear(nullptr, 0);
+
+    for (const auto block : compute_sorted_blocks)
+        if (!block->lower(tape))
+            tape.call(block);
+
+    is_tape_compiled = true;
+}
+
+/**
+ * Расчёт схемы по ленте инструкций.
+ * Результаты побитово совпадают с compute(), состояние блоков синхронизируется с лентой,
+ * поэтому движки можно чередовать между вызовами. При разных периодах дискретизации блоков - обычный compute().
+ * @param steps количество шагов интегрирования
+ */
+void Scheme::computeTape(const uint64_t steps) {
+    if (is_multirate) {
+        compute(steps);
+        return;
+    }
+    if (!is_tape_compiled)
+        compileTape();
+
+    const auto it = port_memory.find(types::type_hash<Type>());
+    auto* memory  = it != port_memory.end() ? reinterpret_cast<Type*>(it->second.data()) : nullptr;
+
+    tape.load();
+    for (size i = 0; i < steps; ++i) {
+        time += dt;
+        tape.execute(memory, input_buffer.data(), time);
+    }
+    tape.store();
+    dt_count += steps;
+}
+
+/**
+ * Пакетный расчёт lanes независимых экземпляров схемы.
+ * Текущее состояние схемы становится начальным для всех экземпляров,
+ * дальше экземпляры различаются параметрами, входами и начальными условиями, заданными через Batch.
+ * Начальные условия блоков (y0) задаются параметрами, только если схема ещё не рассчитывалась.
+ * @param lanes количество экземпляров
+ */
+Batch Scheme::makeBatch(const size lanes) {
+    auto instructions = block_instructions();
+
+    const auto it = port_memory.find(types::type_hash<Type>());
+    const auto* memory = it != port_memory.end() ? reinterpret_cast<const Type*>(it->second.data()) : nullptr;
+    return {tape, memory, {input_buffer.begin(), input_buffer.end()}, std::move(instructions), time, dt,
+            dt_count == 0, lanes};
+}
+
+/**
+ * Расчёт чувствительности: производные вещественных портов по параметрам блоков.
+ * Текущее состояние схемы становится начальным; производные по начальным условиям блоков (y0)
+ * ненулевые, только если схема ещё не рассчитывалась.
+ * @param varied параметры (блок, индекс параметра блока - см. Sensitivity)
+ */
+Sensitivity Scheme::makeSensitivity(const std::vector<Sensitivity::Parameter>& varied) {
+    const auto instructions = block_instructions();
+
+    const auto it = port_memory.find(types::type_hash<Type>());
+    const auto* memory = it != port_memory.end() ? reinterpret_cast<const Type*>(it->second.data()) : nullptr;
+    return {tape, memory, {input_buffer.begin(), input_buffer.end()}, instructions, time, dt, dt_count == 0, varied};
+}
+
+/// Индекс инструкции ленты для каждого блока схемы (-1, если блок не в ленте); лента компилируется и синхронизируется
+std::vector<types::size> Scheme::block_instructions() {
+    if (!is_tape_compiled)
+        compileTape();
+    tape.load();
+
+    std::unordered_map<const Block*, size> instruction_of;
+    const auto& code = tape.getCode();
+    for (size i = 0; i < code.size(); ++i)
+        instruction_of[code[i].block] = i;
+
+    std::vector<size> instructions(blocks.size(), static_cast<size>(-1));
+    for (size i = 0; i < blocks.size(); ++i)
+        if (const auto it = instruction_of.find(blocks[i].get()); it != instruction_of.end())
+            instructions[i] = it->second;
+    return instructions;
+}
+}
\ No newline at end of file
@@ -0,0 +1,169 @@
+#include "batch.hpp"
+
+#include "block.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace nrcki {
+using types::size;
+using types::real;
+
+namespace {
+/// Размножение значений по полосам: values[i] -> [i * lanes, (i + 1) * lanes)
+std::vector<real> broadcast(const real* values, const size count, const size lanes) {
+    std::vector<real> result(count * lanes);
+    for (size i = 0; i < count; ++i)
+        std::fill_n(result.begin() + i * lanes, lanes, values[i]);
+    return result;
+}
+
+/// Значения [begin, end) полосы lane подряд
+std::vector<real> gather(const std::vector<real>& from, const size begin, const size end, const size lane,
+                         const size lanes) {
+    std::vector<real> result(end - begin);
+    for (size i = begin; i < end; ++i)
+        result[i - begin] = from[i * lanes + lane];
+    return result;
+}
+
+void scatter(const std::vector<real>& from, std::vector<real>& to, const size begin, const size lane,
+             const size lanes) {
+    for (size i = 0; i < from.size(); ++i)
+        to[(begin + i) * lanes + lane] = from[i];
+}
+}
+
+/**
+ * @param compiled скомпилированная лента схемы (без вызовов Block::compute())
+ * @param ports_memory текущие значения вещественных портов схемы - начальные условия всех экземпляров
+ * @param signals текущие значения внешних входов схемы
+ * @param block_instructions индекс инструкции для каждого блока схемы
+ * @param start текущее время схемы
+ * @param step шаг интегрирования схемы
+ * @param initial_state схема в начальном состоянии: начальные условия блоков задают выходы и состояние полос
+ * @param lanes_count количество экземпляров
+ */
+Batch::Batch(const Tape& compiled, const real* ports_memory, const std::vector<real>& signals,
+             std::vector<size> block_instructions, const types::time start, const types::time step,
+             const bool initial_state, const size lanes_count) :
+    tape(compiled), lanes(lanes_count), instructions(std::move(block_instructions)), own(instructions.size()),
+    initial(initial_state), time(start), dt(step) {
+    if (lanes == 0)
+        throw std::runtime_error("Batch: lanes count must be positive");
+    if (tape.getCallCount())
+        throw std::runtime_error("Batch: scheme contains blocks without tape lowering");
+
+    memory = broadcast(ports_memory, tape.getSlotCount(), lanes);
+    state  = broadcast(tape.getState().data(), tape.getState().size(), lanes);
+    params = broadcast(tape.getParams().data(), tape.getParams().size(), lanes);
+    inputs = broadcast(signals.data(), signals.size(), lanes);
+
+    // Параметры блоков, задающих их (Block::getParameters()), - общие для всех полос
+    std::vector<real> block_values;
+    const auto& code = tape.getCode();
+    for (size block = 0; block < instructions.size(); ++block) {
+        if (instructions[block] >= code.size())
+            continue;
+        const auto parameters = code[instructions[block]].block->getParameters();
+        own[block]            = {block_values.size(), block_values.size() + parameters.size()};
+        block_values.insert(block_values.end(), parameters.begin(), parameters.end());
+    }
+    values = broadcast(block_values.data(), block_values.size(), lanes);
+}
+
+/**
+ * Расчёт всех экземпляров.
+ * @param steps количество шагов интегрирования
+ */
+void Batch::compute(const uint64_t steps) {
+    for (size i = 0; i < steps; ++i) {
+        time += dt;
+        tape.execute(memory.data(), state.data(), params.data(), inputs.data(), time, lanes);
+    }
+    dt_count += steps;
+}
+
+bool Batch::has_own(const size block) const {
+    return block < own.size() && own[block].first != own[block].second;
+}
+
+size Batch::param_offset(const size block, const size index) const {
+    const auto& code = tape.getCode();
+    if (block >= instructions.size() || instructions[block] >= code.size())
+        throw std::runtime_error("Batch: block has no tape instruction");
+
+    const auto [begin, end] = has_own(block) ? own[block] : tape.getParamRange(instructions[block]);
+    if (begin + index >= end)
+        throw std::runtime_error("Batch: parameter index out of range");
+    return begin + index;
+}
+
+size Batch::state_offset(const size block, const size index) const {
+    const auto& code = tape.getCode();
+    if (block >= instructions.size() || instructions[block] >= code.size())
+        throw std::runtime_error("Batch: block has no tape instruction");
+
+    const auto [begin, end] = tape.getStateRange(instructions[block]);
+    if (begin + index >= end)
+        throw std::runtime_error("Batch: state index out of range");
+    return begin + index;
+}
+
+real Batch::getParameter(const size block, const size index, const size lane) const {
+    const auto offset = param_offset(block, index);
+    return (has_own(block) ? values : params)[offset * lanes + lane];
+}
+
+/**
+ * Параметр экземпляра lane. Параметр блока пересчитывается блоком в коэффициенты инструкции полосы,
+ * встроенный параметр инструкции блока без своих параметров записывается как есть.
+ */
+void Batch::setParameter(const size block, const size index, const size lane, const real value) {
+    const auto offset = param_offset(block, index);
+    if (!has_own(block)) {
+        params[offset * lanes + lane] = value;
+        return;
+    }
+
+    values[offset * lanes + lane] = value;
+    lower_lane(block, lane);
+}
+
+void Batch::lower_lane(const size block, const size lane) {
+    const auto& ins         = tape.getCode()[instructions[block]];
+    const auto block_values = gather(values, own[block].first, own[block].second, lane, lanes);
+
+    // Блок перезаписывает свои коэффициенты, остальные параметры инструкции (например, число узлов) - прежние
+    if (!initial || dt_count) {
+        const auto [begin, end] = tape.getParamRange(instructions[block]);
+        auto lane_params        = gather(params, begin, end, lane, lanes);
+        ins.block->lowerValues(block_values.data(), lane_params.data(), nullptr, nullptr);
+        scatter(lane_params, params, begin, lane, lanes);
+        return;
+    }
+
+    // Начальное состояние полосы lane: начальные условия блока, затем init() по новым параметрам;
+    // остальные полосы не изменяются
+    auto lane_memory       = gather(memory, 0, tape.getSlotCount(), lane, lanes);
+    auto lane_state        = gather(state, 0, tape.getState().size(), lane, lanes);
+    auto lane_params       = gather(params, 0, tape.getParams().size(), lane, lanes);
+    const auto lane_inputs = gather(inputs, 0, inputs.size() / lanes, lane, lanes);
+
+    ins.block->lowerValues(block_values.data(), lane_params.data() + ins.param, lane_memory.data() + ins.out,
+                           lane_state.data() + ins.state);
+    tape.initialize(lane_memory.data(), lane_state.data(), lane_params.data(), lane_inputs.data(), time, 1);
+
+    scatter(lane_memory, memory, 0, lane, lanes);
+    scatter(lane_state, state, 0, lane, lanes);
+    scatter(lane_params, params, 0, lane, lanes);
+}
+
+real Batch::getState(const size block, const size index, const size lane) const {
+    return state[state_offset(block, index) * lanes + lane];
+}
+
+void Batch::setState(const size block, const size index, const size lane, const real value) {
+    state[state_offset(block, index) * lanes + lane] = value;
+}
+}
\ No newline at end of file
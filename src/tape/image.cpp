@@ -0,0 +1,196 @@
+#include "image.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace nrcki {
+using types::size;
+using types::real;
+
+namespace {
+/// Участок внутри образа по границам и выравниванию
+template <typename T>
+T* section(types::byte* image, const size bytes, const ImageHeader::Section& section) {
+    if (section.offset % alignof(T) || section.offset > bytes || section.count > (bytes - section.offset) / sizeof(T))
+        throw std::runtime_error("SchemeImage: section is outside of the image");
+    return reinterpret_cast<T*>(image + section.offset);
+}
+}
+
+SchemeImage::SchemeImage(const std::string& path) {
+#ifdef _WIN32
+    const auto file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        throw std::runtime_error("SchemeImage: cannot open " + path);
+    LARGE_INTEGER length;
+    GetFileSizeEx(file, &length);
+    const auto view = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!view)
+        throw std::runtime_error("SchemeImage: cannot map " + path);
+    mapping = MapViewOfFile(view, FILE_MAP_COPY, 0, 0, 0);
+    CloseHandle(view);
+    if (!mapping)
+        throw std::runtime_error("SchemeImage: cannot map " + path);
+    mapping_size = static_cast<size>(length.QuadPart);
+#else
+    const int file = open(path.c_str(), O_RDONLY);
+    if (file < 0)
+        throw std::runtime_error("SchemeImage: cannot open " + path);
+    struct stat info{};
+    if (fstat(file, &info) != 0) {
+        close(file);
+        throw std::runtime_error("SchemeImage: cannot stat " + path);
+    }
+    mapping_size = static_cast<size>(info.st_size);
+    void* address = mapping_size ? mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0) : MAP_FAILED;
+    close(file);
+    if (address == MAP_FAILED)
+        throw std::runtime_error("SchemeImage: cannot map " + path);
+    mapping = address;
+#endif
+
+    try {
+        bind(static_cast<byte*>(mapping), mapping_size);
+    }
+    catch (...) {
+        unmap();
+        throw;
+    }
+}
+
+SchemeImage::SchemeImage(const std::span<byte> image) {
+    if (reinterpret_cast<std::uintptr_t>(image.data()) % ImageHeader::alignment)
+        throw std::runtime_error("SchemeImage: image is not aligned");
+    bind(image.data(), image.size());
+}
+
+SchemeImage::SchemeImage(SchemeImage&& other) noexcept {
+    *this = std::move(other);
+}
+
+SchemeImage& SchemeImage::operator=(SchemeImage&& other) noexcept {
+    if (this != &other) {
+        unmap();
+        mapping      = std::exchange(other.mapping, nullptr);
+        mapping_size = std::exchange(other.mapping_size, 0);
+        code         = std::exchange(other.code, {});
+        operands     = std::exchange(other.operands, nullptr);
+        params       = std::exchange(other.params, nullptr);
+        state        = std::exchange(other.state, nullptr);
+        memory       = std::exchange(other.memory, nullptr);
+        inputs       = std::exchange(other.inputs, {});
+        outputs      = std::exchange(other.outputs, {});
+        dt_count     = other.dt_count;
+        time         = other.time;
+        dt           = other.dt;
+    }
+    return *this;
+}
+
+SchemeImage::~SchemeImage() {
+    unmap();
+}
+
+void SchemeImage::unmap() {
+    if (!mapping)
+        return;
+#ifdef _WIN32
+    UnmapViewOfFile(mapping);
+#else
+    munmap(mapping, mapping_size);
+#endif
+    mapping = nullptr;
+}
+
+/**
+ * Проверка заголовка и привязка участков образа.
+ * Образ должен быть собран той же сборкой библиотеки (формат, размеры инструкции и вещественного типа).
+ */
+void SchemeImage::bind(byte* image, const size bytes) {
+    if (bytes < sizeof(ImageHeader))
+        throw std::runtime_error("SchemeImage: image is too small");
+
+    ImageHeader header;
+    std::memcpy(&header, image, sizeof header);
+    if (std::memcmp(header.magic, ImageHeader::signature, sizeof header.magic))
+        throw std::runtime_error("SchemeImage: not a scheme image");
+    if (header.format != ImageHeader::version)
+        throw std::runtime_error("SchemeImage: unsupported image version");
+    if (header.instruction_size != sizeof(Tape::Instruction) || header.real_size != sizeof(real))
+        throw std::runtime_error("SchemeImage: image was built for a different platform");
+    if (header.image_size > bytes)
+        throw std::runtime_error("SchemeImage: image is truncated");
+
+    code     = {section<const Tape::Instruction>(image, bytes, header.code), header.code.count};
+    operands = section<const slot>(image, bytes, header.operands);
+    params   = section<const real>(image, bytes, header.params);
+    state    = section<real>(image, bytes, header.state);
+    memory   = section<real>(image, bytes, header.memory);
+    inputs   = {section<real>(image, bytes, header.inputs), header.inputs.count};
+    outputs  = {section<const slot>(image, bytes, header.outputs), header.outputs.count};
+
+    // Слоты, параметры и состояние инструкций (все, что читает и пишет расчёт) проверяются один раз,
+    // расчёт идёт без проверок
+    for (const auto& ins : code) {
+        if (ins.op == Tape::Op::Call || ins.op > Tape::Op::SinusSource)
+            throw std::runtime_error("SchemeImage: unsupported instruction");
+        if (ins.out >= header.memory.count || ins.param > header.params.count || ins.state > header.state.count)
+            throw std::runtime_error("SchemeImage: instruction is outside of the image");
+        const auto [operands_count, params_count, state_count] =
+            Tape::extent(ins, params + ins.param, header.params.count - ins.param);
+        if (static_cast<uint64_t>(ins.in) + operands_count > header.operands.count ||
+            static_cast<uint64_t>(ins.param) + params_count > header.params.count ||
+            static_cast<uint64_t>(ins.state) + state_count > header.state.count)
+            throw std::runtime_error("SchemeImage: instruction is outside of the image");
+        for (size j = 0; j < operands_count; ++j)
+            if (operands[ins.in + j] >= (ins.op == Tape::Op::Input ? header.inputs.count : header.memory.count))
+                throw std::runtime_error("SchemeImage: operand is outside of the image");
+    }
+    for (const auto output : outputs)
+        if (output != static_cast<slot>(-1) && output >= header.memory.count)
+            throw std::runtime_error("SchemeImage: output is outside of the image");
+
+    dt_count = header.dt_count;
+    time     = header.time;
+    dt       = header.dt;
+}
+
+/**
+ * Расчёт по ленте образа.
+ * @param steps количество шагов интегрирования
+ */
+void SchemeImage::compute(const uint64_t steps) {
+    for (uint64_t i = 0; i < steps; ++i) {
+        time += dt;
+        Tape::execute(code, operands, memory, state, params, inputs.data(), time);
+    }
+    dt_count += steps;
+}
+
+real SchemeImage::getOutput(const size index) const {
+    if (index >= outputs.size() || outputs[index] == static_cast<slot>(-1))
+        throw std::runtime_error("SchemeImage: output port index out of range");
+    return memory[outputs[index]];
+}
+
+void SchemeImage::setInput(const size index, const real value) {
+    if (index >= inputs.size())
+        throw std::runtime_error("SchemeImage: input index out of range");
+    inputs[index] = value;
+}
+}
\ No newline at end of file
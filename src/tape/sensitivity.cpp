@@ -0,0 +1,102 @@
+#include "sensitivity.hpp"
+
+#include "block.h"
+
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+
+namespace nrcki {
+using types::size;
+using types::real;
+
+namespace {
+/// Значения без производных
+std::vector<Tape::Tangent> constants(const real* values, const size count) {
+    return std::vector<Tape::Tangent>(values, values + count);
+}
+}
+
+/**
+ * @param compiled скомпилированная лента схемы (без вызовов Block::compute())
+ * @param ports_memory текущие значения вещественных портов схемы - начальные условия
+ * @param signals текущие значения внешних входов схемы
+ * @param block_instructions индекс инструкции для каждого блока схемы
+ * @param start текущее время схемы
+ * @param step шаг интегрирования схемы
+ * @param initial схема в начальном состоянии: производные по начальным условиям блоков задаются на выходах
+ * @param varied параметры, по которым рассчитываются производные
+ */
+Sensitivity::Sensitivity(const Tape& compiled, const real* ports_memory, std::vector<real> signals,
+                         const std::vector<size>& block_instructions, const types::time start, const types::time step,
+                         const bool initial, const std::vector<Parameter>& varied) :
+    tape(compiled), parameters(varied.size()), inputs(std::move(signals)), time(start), dt(step) {
+    if (varied.empty())
+        throw std::runtime_error("Sensitivity: no parameters");
+    if (tape.getCallCount())
+        throw std::runtime_error("Sensitivity: scheme contains blocks without tape lowering");
+
+    const auto& code = tape.getCode();
+    for (const auto& [block, index] : varied) {
+        if (block >= block_instructions.size() || block_instructions[block] >= code.size())
+            throw std::runtime_error("Sensitivity: block has no tape instruction");
+        const auto [begin, end] = tape.getParamRange(block_instructions[block]);
+        const auto count        = code[block_instructions[block]].block->getParameters().size();
+        if (index >= (count ? count : end - begin))
+            throw std::runtime_error("Sensitivity: parameter index out of range");
+    }
+
+    const auto groups = (parameters + Tape::tangent_width - 1) / Tape::tangent_width;
+    memory.assign(groups, constants(ports_memory, tape.getSlotCount()));
+    state.assign(groups, constants(tape.getState().data(), tape.getState().size()));
+    params.assign(groups, constants(tape.getParams().data(), tape.getParams().size()));
+
+    // Параметры блока группы - дуальные переменные; блок пересчитывает из них параметры своей инструкции
+    for (size group = 0; group < groups; ++group) {
+        std::map<size, std::vector<Tangent>> values; // Инструкция -> параметры блока
+        for (size i = group * Tape::tangent_width; i < std::min(parameters, (group + 1) * Tape::tangent_width); ++i) {
+            const auto instruction = block_instructions[varied[i].block];
+            const auto begin       = tape.getParamRange(instruction).first;
+            const auto own         = code[instruction].block->getParameters();
+
+            if (own.empty())
+                params[group][begin + varied[i].index].grad[i % Tape::tangent_width] = 1;
+            else {
+                auto [it, inserted] = values.try_emplace(instruction);
+                if (inserted)
+                    it->second = constants(own.data(), own.size());
+                it->second[varied[i].index].grad[i % Tape::tangent_width] = 1;
+            }
+        }
+
+        for (const auto& [instruction, block_values] : values) {
+            const auto& ins = code[instruction];
+            ins.block->lowerTangent(block_values.data(), params[group].data() + ins.param,
+                                    initial ? memory[group].data() + ins.out : nullptr,
+                                    initial ? state[group].data() + ins.state : nullptr);
+        }
+
+        // Начальные выходы и состояние, рассчитанные init() по параметрам, получают их производные; значения - прежние
+        if (initial) {
+            tape.initialize(memory[group].data(), state[group].data(), params[group].data(), inputs.data(), time);
+            for (size i = 0; i < memory[group].size(); ++i)
+                memory[group][i].value = ports_memory[i];
+            for (size i = 0; i < state[group].size(); ++i)
+                state[group][i].value = tape.getState()[i];
+        }
+    }
+}
+
+/**
+ * Расчёт значений и производных.
+ * @param steps количество шагов интегрирования
+ */
+void Sensitivity::compute(const uint64_t steps) {
+    for (size i = 0; i < steps; ++i) {
+        time += dt;
+        for (size group = 0; group < memory.size(); ++group)
+            tape.execute(memory[group].data(), state[group].data(), params[group].data(), inputs.data(), time);
+    }
+    dt_count += steps;
+}
+}
\ No newline at end of file
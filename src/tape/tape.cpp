@@ -0,0 +1,505 @@
+#include "tape.hpp"
+#include "block.h"
+#include "kernels.hpp"
+#include "pack.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+namespace nrcki {
+using types::size;
+using types::real;
+
+void Tape::clear(const real* ports_memory, const size count) {
+    code.clear();
+    operands.clear();
+    params.clear();
+    state.clear();
+    origins.clear();
+
+    memory      = ports_memory;
+    memory_size = count;
+}
+
+bool Tape::emit(const Op op, const Block* block, const Ports<real>* ports,
+                const std::vector<real>& parameters, const std::vector<real*>& states) {
+    const slot out = ports->output_count ? slotOf(ports->outputs) : 0;
+    if (out == static_cast<slot>(-1))
+        return false;
+
+    const auto in = operands.size();
+    for (size i = 0; i < ports->input_count; ++i) {
+        const auto index = slotOf(ports->inputs[i]);
+        if (index == static_cast<slot>(-1)) {
+            operands.resize(in);
+            return false;
+        }
+        operands.push_back(index);
+    }
+
+    code.push_back({
+        op, static_cast<slot>(ports->input_count), out,
+        static_cast<slot>(in), static_cast<slot>(params.size()), static_cast<slot>(state.size()),
+        block
+    });
+    params.insert(params.end(), parameters.begin(), parameters.end());
+    for (const auto origin : states) {
+        state.push_back(*origin);
+        origins.push_back(origin);
+    }
+    return true;
+}
+
+bool Tape::emitInput(const Block* block, const Ports<real>* ports, const size signal_index) {
+    const auto out = slotOf(ports->outputs);
+    if (out == static_cast<slot>(-1))
+        return false;
+
+    code.push_back({
+        Op::Input, 1, out,
+        static_cast<slot>(operands.size()), static_cast<slot>(params.size()), static_cast<slot>(state.size()),
+        block
+    });
+    operands.push_back(static_cast<slot>(signal_index));
+    return true;
+}
+
+void Tape::call(const Block* block) {
+    code.push_back({
+        Op::Call, 0, 0,
+        static_cast<slot>(operands.size()), static_cast<slot>(params.size()), static_cast<slot>(state.size()),
+        block
+    });
+}
+
+void Tape::load() {
+    for (size i = 0; i < state.size(); ++i)
+        state[i] = *origins[i];
+}
+
+void Tape::store() const {
+    for (size i = 0; i < state.size(); ++i)
+        *origins[i] = state[i];
+}
+
+size Tape::getCallCount() const {
+    return std::ranges::count(code, Op::Call, &Instruction::op);
+}
+
+std::pair<size, size> Tape::getParamRange(const size instruction) const {
+    return {code[instruction].param, instruction + 1 < code.size() ? code[instruction + 1].param : params.size()};
+}
+
+std::pair<size, size> Tape::getStateRange(const size instruction) const {
+    return {code[instruction].state, instruction + 1 < code.size() ? code[instruction + 1].state : state.size()};
+}
+
+/**
+ * Размеры, которые читает и пишет инструкция при расчёте (раскладка - см. run).
+ * Число узлов кусочно-линейной характеристики читается из параметров инструкции:
+ * при некорректном числе узлов требуется больше параметров, чем доступно.
+ * @param params встроенные параметры инструкции
+ * @param available число параметров от начала params
+ */
+Tape::Extent Tape::extent(const Instruction& ins, const real* params, const size available) {
+    const size count = std::max<size>(ins.count, 1);
+    switch (ins.op) {
+        case Op::Call:
+            return {0, 0, 0};
+        case Op::Input:
+        case Op::Copy:
+        case Op::AbsoluteValue:
+        case Op::Negate:
+        case Op::Sign:
+        case Op::Not:
+            return {1, 0, 0};
+        case Op::Summator:
+            return {count, count, 0};
+        case Op::Multiplier:
+        case Op::Xor:
+        case Op::XorNot:
+            return {count, 0, 0};
+        case Op::And:
+        case Op::Or:
+        case Op::AndNot:
+        case Op::OrNot:
+            return {ins.count, 0, 0};
+        case Op::Divider:
+            return {2, 1, 0};
+        case Op::Equal:
+        case Op::NotEqual:
+        case Op::Less:
+        case Op::Greater:
+        case Op::LessOrEqual:
+        case Op::GreaterOrEqual:
+        case Op::RsTrigger:
+        case Op::SrTrigger:
+            return {2, 0, 0};
+        case Op::Saturation:
+            return {1, 6, 0};
+        case Op::Deadband:
+            return {1, 3, 0};
+        case Op::Hysteresis:
+            return {1, 4, 0};
+        case Op::LowThreshold:
+        case Op::HighThreshold:
+            return {1, 2, 0};
+        case Op::PiecewiseLinearSL:
+        case Op::PiecewiseLinearEL:
+        case Op::PiecewiseLinearSB:
+        case Op::PiecewiseLinearEB: {
+            // [n, x[n], y[n], (k, b)[n]]
+            if (available == 0)
+                return {1, 1, 0};
+            const auto n = params[0];
+            if (!(n >= 1 && n <= static_cast<real>(available)) || n != std::floor(n))
+                return {1, available + 1, 0};
+            return {1, 1 + 4 * static_cast<size>(n), 0};
+        }
+        case Op::ToggleSwitch:
+            return {3, 0, 0};
+        case Op::Integrator:
+            return {1, 1, 0};
+        case Op::Inertial:
+            return {1, 2, 0};
+        case Op::InertialDifferential:
+            return {1, 2, 1};
+        case Op::Oscillatory:
+            return {1, 6, 2};
+        case Op::StepDelay:
+            return {1, 0, 1};
+        case Op::Step:
+        case Op::SinusSource:
+            return {0, 3, 0};
+        case Op::LinearSource:
+            return {0, 2, 0};
+    }
+    return {0, 0, 0};
+}
+
+/// Скалярный расчёт: собственные параметры и состояние ленты, одна полоса
+void Tape::execute(real* ports_memory, const real* inputs, const types::time time) {
+    run<real, false>(code, operands.data(), ports_memory, state.data(), params.data(), inputs, time, 1);
+}
+
+/// Пакетный расчёт: слоты, параметры, состояние и входы хранятся полосами [index * lanes + lane]
+void Tape::execute(real* ports_memory, real* lanes_state, const real* lanes_params,
+                   const real* inputs, const types::time time, const size lanes) const {
+    run<real, true>(code, operands.data(), ports_memory, lanes_state, lanes_params, inputs, time, lanes);
+}
+
+/// Расчёт в дуальных числах: значения и производные слотов, параметров и состояния, одна полоса
+void Tape::execute(Tangent* ports_memory, Tangent* tangent_state, const Tangent* tangent_params,
+                   const real* inputs, const types::time time) const {
+    run<Tangent, false>(code, operands.data(), ports_memory, tangent_state, tangent_params, inputs, time, 1);
+}
+
+/**
+ * Начальное состояние - повторение Block::init():
+ * выходы динамических звеньев - начальные условия (уже заданы), состояние, снимаемое с входа, - по входу,
+ * выходы остальных инструкций рассчитываются по порядку.
+ */
+template <typename Value, bool Batched>
+void Tape::init(Value* m, Value* s, const Value* p, const real* inputs, const types::time time,
+                const size lanes) const {
+    for (const auto& ins : code) {
+        switch (ins.op) {
+            case Op::Integrator:
+            case Op::Inertial:
+            case Op::Oscillatory:
+                break;
+            // z: [prev_x]
+            case Op::InertialDifferential:
+            case Op::StepDelay:
+                for (size l = 0; l < lanes; ++l)
+                    s[static_cast<size>(ins.state) * lanes + l] = m[static_cast<size>(operands[ins.in]) * lanes + l];
+                break;
+            default:
+                run<Value, Batched>({&ins, 1}, operands.data(), m, s, p, inputs, time, lanes);
+                break;
+        }
+    }
+}
+
+/// Производные начального состояния в дуальных числах (см. Sensitivity)
+void Tape::initialize(Tangent* ports_memory, Tangent* tangent_state, const Tangent* tangent_params,
+                      const real* inputs, const types::time time) const {
+    init<Tangent, false>(ports_memory, tangent_state, tangent_params, inputs, time, 1);
+}
+
+/// Начальное состояние полос по их параметрам (см. Batch)
+void Tape::initialize(real* ports_memory, real* lanes_state, const real* lanes_params,
+                      const real* inputs, const types::time time, const size lanes) const {
+    init<real, true>(ports_memory, lanes_state, lanes_params, inputs, time, lanes);
+}
+
+/// Скалярный расчёт по внешней ленте (например, отображённой из образа схемы): инструкции без вызовов блоков
+void Tape::execute(const std::span<const Instruction> code, const slot* operands, real* ports_memory, real* state,
+                   const real* params, const real* inputs, const types::time time) {
+    run<real, false>(code, operands, ports_memory, state, params, inputs, time, 1);
+}
+
+namespace {
+constexpr size pack_width = 4; // Полос в пакете: 4 × double - 256-битный регистр
+using RealPack            = Pack<real, pack_width>;
+
+/// Значение полосы l (для пакета - полос l ... l + pack_width - 1)
+template <typename V, typename Value>
+V lane(const Value* data, const size l) {
+    if constexpr (std::is_same_v<V, Value>)
+        return data[l];
+    else
+        return V::load(data + l);
+}
+
+template <typename V, typename Value>
+void put(Value* data, const size l, const V& value) {
+    if constexpr (std::is_same_v<V, Value>)
+        data[l] = value;
+    else
+        value.store(data + l);
+}
+}
+
+/**
+ * Арифметические операции рассчитываются ядрами kernels.hpp, общими с Block::compute(),
+ * поэтому результат ленты побитово совпадает с виртуальным расчётом.
+ * При Batched полосы обрабатываются пакетами Pack<real, 4> (остаток - по одной полосе),
+ * при Batched = false число полос равно 1 и индексация сводится к скалярной.
+ * Логические операции и кусочно-линейная характеристика (поиск участка ветвлением) рассчитываются по одной полосе.
+ * Value - тип хранения: real, либо Tangent (производные переносятся теми же ядрами; только без Batched и без Call).
+ */
+template <typename Value, bool Batched>
+void Tape::run(const std::span<const Instruction> code, const slot* operands, Value* m, Value* s, const Value* p,
+               const real* inputs, const types::time time, const size lanes) {
+    static_assert(!Batched || std::is_same_v<Value, real>);
+    const size L = Batched ? lanes : 1;
+
+    const auto for_lanes = [L](const auto& body) {
+        size l = 0;
+        if constexpr (Batched)
+            for (; l + pack_width <= L; l += pack_width)
+                body.template operator()<RealPack>(l);
+        for (; l < L; ++l)
+            body.template operator()<Value>(l);
+    };
+
+#define LANES for (size l = 0; l < L; ++l)
+#define X(J) m[static_cast<size>(x[J]) * L + l]
+#define P(J) q[static_cast<size>(J) * L + l]
+#define Y y[l]
+#define KERNEL(...) for_lanes([&]<typename V>(const size l) { __VA_ARGS__; })
+#define VX(J) lane<V>(m + static_cast<size>(x[J]) * L, l)
+#define VP(J) lane<V>(q + static_cast<size>(J) * L, l)
+#define VY lane<V>(y, l)
+#define ZS(J) (z + static_cast<size>(J) * L)
+    for (const auto& ins : code) {
+        const slot* x = operands + ins.in;
+        const Value* q = p + static_cast<size>(ins.param) * L;
+        Value* y       = m + static_cast<size>(ins.out) * L;
+        Value* z       = s + static_cast<size>(ins.state) * L;
+
+        switch (ins.op) {
+            case Op::Call:
+                if constexpr (!Batched && std::is_same_v<Value, real>)
+                    ins.block->compute();
+                break;
+
+            case Op::Input:
+                LANES Y = inputs[static_cast<size>(x[0]) * L + l];
+                break;
+            case Op::Copy:
+                LANES Y = X(0);
+                break;
+
+            case Op::Summator:
+                KERNEL(put(y, l, kernels::summator<V>(ins.count,
+                                                      [&](const slot j) { return VP(j); },
+                                                      [&](const slot j) { return VX(j); })));
+                break;
+            case Op::Multiplier:
+                KERNEL(put(y, l, kernels::multiplier<V>(ins.count, [&](const slot j) { return VX(j); })));
+                break;
+            case Op::Divider:
+                KERNEL(put(y, l, kernels::divider(VX(0), VX(1), VP(0))));
+                break;
+            case Op::AbsoluteValue:
+                KERNEL(put(y, l, kernels::absolute(VX(0))));
+                break;
+            case Op::Negate:
+                KERNEL(put(y, l, kernels::negate(VX(0))));
+                break;
+            case Op::Sign:
+                KERNEL(put(y, l, kernels::sign(VX(0))));
+                break;
+            case Op::And:
+            case Op::AndNot:
+                LANES {
+                    bool res = true;
+                    for (slot j = 0; j < ins.count; ++j)
+                        if (X(j) == 0) {
+                            res = false;
+                            break;
+                        }
+                    Y = res != (ins.op == Op::AndNot);
+                }
+                break;
+            case Op::Or:
+            case Op::OrNot:
+                LANES {
+                    bool res = false;
+                    for (slot j = 0; j < ins.count; ++j)
+                        if (X(j) != 0) {
+                            res = true;
+                            break;
+                        }
+                    Y = res != (ins.op == Op::OrNot);
+                }
+                break;
+            case Op::Xor:
+            case Op::XorNot:
+                LANES {
+                    bool res = X(0) != 0;
+                    for (slot j = 1; j < ins.count; ++j)
+                        res ^= X(j) != 0;
+                    Y = res != (ins.op == Op::XorNot);
+                }
+                break;
+            case Op::Not:
+                LANES Y = X(0) == 0;
+                break;
+            case Op::Equal:
+                LANES Y = X(0) == X(1);
+                break;
+            case Op::NotEqual:
+                LANES Y = X(0) != X(1);
+                break;
+            case Op::Less:
+                LANES Y = X(0) < X(1);
+                break;
+            case Op::Greater:
+                LANES Y = X(0) > X(1);
+                break;
+            case Op::LessOrEqual:
+                LANES Y = X(0) <= X(1);
+                break;
+            case Op::GreaterOrEqual:
+                LANES Y = X(0) >= X(1);
+                break;
+
+            // p: [x1, x2, y1, y2, k, b]
+            case Op::Saturation:
+                KERNEL(put(y, l, kernels::saturation(VX(0), VP(0), VP(1), VP(2), VP(3), VP(4), VP(5))));
+                break;
+            // p: [x1, x2, k]
+            case Op::Deadband:
+                KERNEL(put(y, l, kernels::deadband(VX(0), VP(0), VP(1), VP(2))));
+                break;
+            // p: [x1, x2, y1, y2]
+            case Op::Hysteresis:
+                KERNEL(put(y, l, kernels::hysteresis(VX(0), VP(0), VP(1), VP(2), VP(3), VY)));
+                break;
+            // p: [activation, deactivation]
+            case Op::LowThreshold:
+                KERNEL(put(y, l, kernels::lowThreshold(VX(0), VP(0), VP(1), VY)));
+                break;
+            case Op::HighThreshold:
+                KERNEL(put(y, l, kernels::highThreshold(VX(0), VP(0), VP(1), VY)));
+                break;
+
+            // p: [n, x[n], y[n], (k, b)[n]], n одинаково во всех полосах
+            case Op::PiecewiseLinearSL:
+            case Op::PiecewiseLinearEL:
+            case Op::PiecewiseLinearSB:
+            case Op::PiecewiseLinearEB: {
+                using kernels::primal;
+                const auto n      = static_cast<size>(primal(q[0]));
+                const bool extra  = ins.op == Op::PiecewiseLinearEL || ins.op == Op::PiecewiseLinearEB;
+                const bool binary = ins.op == Op::PiecewiseLinearSB || ins.op == Op::PiecewiseLinearEB;
+                LANES Y = kernels::piecewiseLinear(X(0), n,
+                                                   [&](const size i) { return P(1 + i); },
+                                                   [&](const size i) { return P(1 + n + i); },
+                                                   [&](const size i) { return P(1 + 2 * n + 2 * i); },
+                                                   [&](const size i) { return P(1 + 2 * n + 2 * i + 1); },
+                                                   extra, binary);
+                break;
+            }
+
+            case Op::ToggleSwitch:
+                KERNEL(put(y, l, kernels::toggleSwitch(VX(0), VX(1), VX(2))));
+                break;
+            case Op::RsTrigger:
+                LANES {
+                    if (X(1) != 0)
+                        Y = false;
+                    else if (X(0) != 0)
+                        Y = true;
+                }
+                break;
+            case Op::SrTrigger:
+                LANES {
+                    if (X(0) != 0)
+                        Y = true;
+                    else if (X(1) != 0)
+                        Y = false;
+                }
+                break;
+
+            // p: [k·dt]
+            case Op::Integrator:
+                KERNEL(put(y, l, kernels::integrator(VY, VP(0), VX(0))));
+                break;
+            // p: [k, a] (a = dt/T для метода Эйлера)
+            case Op::Inertial:
+                KERNEL(put(y, l, kernels::inertial(VY, VP(0), VP(1), VX(0))));
+                break;
+            // p: [c_x, c_y] (k/T, dt/T для метода Эйлера), z: [prev_x]
+            case Op::InertialDifferential:
+                KERNEL(
+                    V prev_x = lane<V>(ZS(0), l);
+                    put(y, l, kernels::inertialDifferential(VY, prev_x, VP(0), VP(1), VX(0)));
+                    put(ZS(0), l, prev_x));
+                break;
+            // p: [phi00, phi01, phi10, phi11, gamma0, gamma1], z: [dy, prev_y]
+            case Op::Oscillatory:
+                KERNEL(
+                    V dy     = lane<V>(ZS(0), l);
+                    V prev_y = lane<V>(ZS(1), l);
+                    put(y, l, kernels::oscillatory(VY, dy, prev_y, VP(0), VP(1), VP(2), VP(3), VP(4), VP(5), VX(0)));
+                    put(ZS(0), l, dy);
+                    put(ZS(1), l, prev_y));
+                break;
+            // z: [prev_x]
+            case Op::StepDelay:
+                KERNEL(
+                    V prev_x = lane<V>(ZS(0), l);
+                    put(y, l, kernels::stepDelay(prev_x, VX(0)));
+                    put(ZS(0), l, prev_x));
+                break;
+
+            // p: [time, value, y0]
+            case Op::Step:
+                KERNEL(put(y, l, kernels::step(V(static_cast<real>(time)), VP(0), VP(2), VP(1))));
+                break;
+            // p: [k, b]
+            case Op::LinearSource:
+                KERNEL(put(y, l, kernels::linearSource(VP(0), VP(1), static_cast<real>(time))));
+                break;
+            // p: [a, w, f]
+            case Op::SinusSource:
+                KERNEL(put(y, l, kernels::sinusSource(VP(0), VP(1), VP(2), static_cast<real>(time))));
+                break;
+        }
+    }
+#undef LANES
+#undef X
+#undef P
+#undef Y
+#undef KERNEL
+#undef VX
+#undef VP
+#undef VY
+#undef ZS
+}
+}
\ No newline at end of file
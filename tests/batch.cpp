@@ -0,0 +1,149 @@
+#include "common.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+namespace test {
+namespace {
+constexpr uint64_t steps = 2000;
+
+/// Изменение параметра полосы: блок, индекс параметра блока и параметры скалярной схемы с тем же значением
+struct Edit {
+    size block, index;
+    double value;
+    Plant plant;
+};
+
+std::vector<Edit> edits() {
+    std::vector<Edit> result;
+    const auto add = [&result](const size block, const size index, const double value, auto change) {
+        Plant plant;
+        change(plant, value);
+        result.push_back({block, index, value, plant});
+    };
+    add(3, 0, -0.1, [](Plant& p, const double v) { p.saturation_x1 = v; });
+    add(4, 1, 2.5, [](Plant& p, const double v) { p.inertial_T = v; });
+    add(5, 2, 0.7, [](Plant& p, const double v) { p.oscillatory_b = v; });
+    add(5, 3, 0.4, [](Plant& p, const double v) { p.oscillatory_y0 = v; });
+    add(6, 0, 0.03, [](Plant& p, const double v) { p.integrator_k = v; });
+    add(7, 4, -0.2, [](Plant& p, const double v) { p.node_y1 = v; });
+    return result;
+}
+
+/// Выходы скалярной схемы с параметрами plant
+std::vector<double> scalar(const Plant& plant) {
+    Scheme scheme;
+    buildPlant(scheme, plant);
+    linkPlant(scheme);
+    scheme.computeTape(steps);
+    return outputs(scheme, plant_blocks);
+}
+
+/// Полоса i + 1 с изменённым параметром совпадает со скалярной схемой, построенной с тем же параметром
+void lanes_match_scalar() {
+    const auto cases = edits();
+
+    Scheme scheme;
+    buildPlant(scheme);
+    linkPlant(scheme);
+    auto batch = scheme.makeBatch(cases.size() + 1);
+    for (size i = 0; i < cases.size(); ++i)
+        batch.setParameter(cases[i].block, cases[i].index, i + 1, cases[i].value);
+    batch.compute(steps);
+
+    for (size lane = 0; lane <= cases.size(); ++lane) {
+        const auto expected = scalar(lane ? cases[lane - 1].plant : Plant{});
+        for (size port = 0; port < plant_blocks; ++port)
+            if (!near(batch.getOutput(port, lane), expected[port])) {
+                std::fprintf(stderr, "lane %zu port %zu: %.17g != %.17g\n", static_cast<std::size_t>(lane),
+                             static_cast<std::size_t>(port), batch.getOutput(port, lane), expected[port]);
+                CHECK(false);
+            }
+    }
+}
+
+/// Выходы и состояние полосы lane
+std::vector<double> lane_values(const nrcki::Batch& batch, const size lane) {
+    std::vector<double> values;
+    for (size port = 0; port < plant_blocks; ++port)
+        values.push_back(batch.getOutput(port, lane));
+    for (const auto [block, index] : {std::pair<size, size>{5, 0}, {5, 1}, {8, 0}, {9, 0}})
+        values.push_back(batch.getState(block, index, lane));
+    return values;
+}
+
+/// Начальное состояние, пересчитанное после изменения параметра полосы, не затрагивает остальные полосы
+void lanes_isolated() {
+    Scheme scheme;
+    buildPlant(scheme);
+    linkPlant(scheme);
+    auto batch = scheme.makeBatch(3);
+
+    batch.setState(8, 0, 0, 0.25);
+    batch.setState(9, 0, 0, -0.5);
+    batch.setOutput(3, 0, 0.75);
+    batch.setOutput(2, 2, -0.3);
+    const auto first = lane_values(batch, 0), last = lane_values(batch, 2);
+
+    batch.setParameter(3, 0, 1, -0.1);
+    batch.setParameter(5, 3, 1, 0.4);
+    CHECK(lane_values(batch, 0) == first);
+    CHECK(lane_values(batch, 2) == last);
+    CHECK(batch.getOutput(5, 1) == 0.4);
+}
+
+/// Параметры блока читаются в своих единицах; производные коэффициенты напрямую не задаются
+void parameters() {
+    Scheme scheme;
+    buildPlant(scheme);
+    linkPlant(scheme);
+    auto batch = scheme.makeBatch(2);
+
+    batch.setParameter(4, 1, 1, 2.5);
+    CHECK(batch.getParameter(4, 1, 1) == 2.5);
+    CHECK(batch.getParameter(4, 1, 0) == Plant{}.inertial_T);
+
+    bool rejected = false;
+    try {
+        batch.setParameter(3, 4, 1, 3); // Наклон ограничения k
+    }
+    catch (const std::runtime_error&) {
+        rejected = true;
+    }
+    CHECK(rejected);
+}
+
+/// Производные чувствительности совпадают с центральными разностями
+void sensitivity() {
+    Scheme scheme;
+    buildPlant(scheme);
+    linkPlant(scheme);
+    auto sensitivity = scheme.makeSensitivity({{4, 1}, {5, 2}});
+    sensitivity.compute(steps);
+
+    constexpr double h = 1e-6;
+    const auto difference = [](auto change, const size port) {
+        Plant plus, minus;
+        change(plus, h);
+        change(minus, -h);
+        return (scalar(plus)[port] - scalar(minus)[port]) / (2 * h);
+    };
+    const auto d_T = difference([](Plant& p, const double d) { p.inertial_T += d; }, 6);
+    const auto d_b = difference([](Plant& p, const double d) { p.oscillatory_b += d; }, 6);
+    CHECK(near(sensitivity.getDerivative(6, 0), d_T, 1e-5));
+    CHECK(near(sensitivity.getDerivative(6, 1), d_b, 1e-5));
+}
+}
+}
+
+/// Полосы пакетного расчёта совпадают со скалярными схемами, построенными с параметрами полос
+int main() {
+    using namespace test;
+    nrcki::types::register_all_types();
+
+    lanes_match_scalar();
+    lanes_isolated();
+    parameters();
+    sensitivity();
+    return report("batch");
+}
\ No newline at end of file
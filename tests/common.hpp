@@ -0,0 +1,88 @@
+#pragma once
+
+#include "nrcki/scheme.h"
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace test {
+using nrcki::Scheme;
+using nrcki::types::link;
+using nrcki::types::size;
+
+inline int failures = 0;
+
+inline void check(const bool condition, const char* expression, const char* file, const int line) {
+    if (condition)
+        return;
+    ++failures;
+    std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expression);
+}
+
+#define CHECK(...) test::check(static_cast<bool>(__VA_ARGS__), #__VA_ARGS__, __FILE__, __LINE__)
+
+/// Код завершения теста: 0, если все проверки выполнены
+inline int report(const char* name) {
+    std::printf("%s: %s (%d failed)\n", name, failures ? "FAILED" : "passed", failures);
+    return failures ? 1 : 0;
+}
+
+/// Значения near совпадают с точностью до относительной погрешности eps
+inline bool near(const double a, const double b, const double eps = 1e-12) {
+    return std::abs(a - b) <= eps * std::max(1.0, std::abs(b));
+}
+
+/// Параметры объекта управления (plant)
+struct Plant {
+    double saturation_x1  = -1;   // Блок 3, параметр 0
+    double inertial_T     = 0.5;  // Блок 4, параметр 1
+    double oscillatory_b  = 0.3;  // Блок 5, параметр 2
+    double oscillatory_y0 = 0;    // Блок 5, параметр 3
+    double integrator_k   = 0.01; // Блок 6, параметр 0
+    double node_y1        = 0.5;  // Блок 7, параметр 4 (y[1])
+};
+
+constexpr size plant_blocks = 10;
+
+/**
+ * Объект управления - все блоки понижаются в ленту:
+ * sin + step - колебательное -> ограничение -> инерционное -> колебательное (обратная связь) -> интегратор
+ * -> кусочно-линейная -> задержка на шаг -> инерционно-дифференцирующее.
+ * Абсолютные индексы выходов совпадают с индексами блоков.
+ */
+inline void buildPlant(Scheme& scheme, const Plant& plant = {}) {
+    double coefficients[3] = {1, 1, -1};
+    double x[3]            = {-2, 0, 2};
+    double y[3]            = {-1, plant.node_y1, 1};
+
+    scheme.addSinusSource(1, 2, 0);
+    scheme.addStep(1, 1, 0);
+    scheme.addSummator(3, coefficients);
+    scheme.addSaturation(plant.saturation_x1, 1, -1, 1);
+    scheme.addInertial(2, plant.inertial_T, 0);
+    scheme.addOscillatory(1, 1, plant.oscillatory_b, plant.oscillatory_y0, 0);
+    scheme.addIntegrator(plant.integrator_k, 0);
+    scheme.addPiecewiseLinear(3, x, y);
+    scheme.addStepDelay();
+    scheme.addInertialDifferential(1, 1, 0);
+}
+
+/// Связи объекта управления [выход, вход]
+inline std::vector<link> plantLinks() {
+    return {0, 0, 1, 1, 5, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9};
+}
+
+inline void linkPlant(Scheme& scheme) {
+    const auto links = plantLinks();
+    scheme.setAbsoluteLinks(static_cast<link>(links.size() / 2), links.data());
+}
+
+/// Вещественные выходы схемы [0, count)
+inline std::vector<double> outputs(const Scheme& scheme, const size count) {
+    std::vector<double> values(count);
+    for (size i = 0; i < count; ++i)
+        values[i] = scheme.getAbsoluteOutputPort<double>(i);
+    return values;
+}
+}
\ No newline at end of file
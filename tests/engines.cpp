@@ -0,0 +1,154 @@
+#include "common.hpp"
+
+#include "image.hpp"
+
+#include <filesystem>
+#include <functional>
+
+namespace test {
+namespace {
+constexpr uint64_t steps  = 3000;
+constexpr size count      = 14; // Выходов схемы
+constexpr uint64_t period = 1000;
+
+/**
+ * Схема: объект управления, логическая часть (гистерезис -> задержка включения, таймер)
+ * и независимый компонент (линейный источник -> инерционное звено).
+ */
+void build(Scheme& scheme, const nrcki::Discretization method) {
+    scheme.setDiscretization(method);
+    buildPlant(scheme);
+    scheme.addHysteresis(0.2, 0.8, 0, 1, false);
+    scheme.addDelayOn(1);
+    scheme.addLinearSource(0.5, 0);
+    scheme.addInertial(1, 2, 0);
+
+    auto links = plantLinks();
+    links.insert(links.end(), {4, 10, 10, 11, 12, 12});
+    scheme.setAbsoluteLinks(static_cast<link>(links.size() / 2), links.data());
+}
+
+using Setup = std::function<void(Scheme&)>;
+using Run   = std::function<void(Scheme&, uint64_t)>;
+
+/// Результат run на steps шагах побитово совпадает с compute()
+void expect_same(const char* name, const nrcki::Discretization method, const Setup& setup, const Run& run) {
+    Scheme reference, scheme;
+    build(reference, method);
+    build(scheme, method);
+    setup(reference);
+    setup(scheme);
+
+    reference.compute(steps);
+    run(scheme, steps);
+    if (outputs(scheme, count) != outputs(reference, count)) {
+        std::fprintf(stderr, "%s (method %d) differs from compute()\n", name, static_cast<int>(method));
+        CHECK(false);
+    }
+}
+
+void engines(const nrcki::Discretization method, const Setup& setup) {
+    expect_same("computeTape", method, setup, [](Scheme& s, const uint64_t n) { s.computeTape(n); });
+    expect_same("computeEvents", method, setup, [](Scheme& s, const uint64_t n) { s.computeEvents(n); });
+    expect_same("computeFastForward", method, setup, [](Scheme& s, const uint64_t n) { s.computeFastForward(n); });
+    expect_same("computeParallel", method, setup, [](Scheme& s, const uint64_t n) {
+        s.setThreads(4, 1);
+        s.computeParallel(n);
+    });
+    expect_same("computeTasks", method, setup, [](Scheme& s, const uint64_t n) {
+        s.setThreads(4, 1);
+        s.computeTasks(n);
+    });
+    expect_same("partition", method, setup, [](Scheme& s, const uint64_t n) {
+        s.partition();
+        s.setThreads(2, 1);
+        s.computeParallel(n);
+    });
+    expect_same("layoutMemory", method, setup, [](Scheme& s, const uint64_t n) {
+        s.layoutMemory();
+        s.compute(n);
+    });
+    expect_same("fork", method, setup, [](Scheme& s, const uint64_t n) {
+        s.compute(period);
+        const auto copy = s.fork();
+        copy->compute(n - period);
+        s.compute(n - period);
+        CHECK(outputs(*copy, count) == outputs(s, count));
+    });
+    expect_same("reset", method, setup, [](Scheme& s, const uint64_t n) {
+        s.compute(period);
+        s.reset();
+        s.compute(n);
+    });
+    expect_same("restoreState", method, setup, [](Scheme& s, const uint64_t n) {
+        s.compute(period);
+        const auto state = s.saveState();
+        s.compute(n - period);
+        s.restoreState(state);
+        s.compute(n - period);
+    });
+}
+
+/// Установившийся объект пропускается быстрой перемоткой и совпадает с compute()
+void fast_forward_settled() {
+    const auto build_settled = [](Scheme& scheme) {
+        scheme.addStep(1, 1, 0);
+        scheme.addInertial(1, 1, 0);
+        scheme.addHysteresis(0.2, 0.8, 0, 1, false);
+        scheme.addDelayOn(2);
+        constexpr link links[6] = {0, 0, 1, 1, 2, 2};
+        scheme.setAbsoluteLinks(3, links);
+    };
+
+    Scheme reference, scheme;
+    build_settled(reference);
+    build_settled(scheme);
+    reference.compute(5000);
+    scheme.setSteadyTolerance(1e-6);
+    scheme.computeFastForward(5000);
+
+    CHECK(outputs(scheme, 4) == outputs(reference, 4));
+    CHECK(scheme.getSkippedSteps() > 4000);
+}
+
+/// Образ схемы, отображённый из файла, рассчитывается так же, как схема
+void image() {
+    Scheme reference, scheme;
+    buildPlant(reference);
+    linkPlant(reference);
+    buildPlant(scheme);
+    linkPlant(scheme);
+
+    const auto path = (std::filesystem::temp_directory_path() / "nrcki-engines.img").string();
+    scheme.saveImage(path);
+    {
+        nrcki::SchemeImage loaded(path);
+        loaded.compute(steps);
+        reference.compute(steps);
+        for (size i = 0; i < plant_blocks; ++i)
+            CHECK(loaded.getOutput(i) == reference.getAbsoluteOutputPort<double>(i));
+    }
+    std::filesystem::remove(path);
+}
+}
+}
+
+/// Все способы расчёта совпадают с compute() побитово, в том числе при разных периодах дискретизации блоков
+int main() {
+    using namespace test;
+    nrcki::types::register_all_types();
+
+    const Setup single_rate = [](Scheme&) {};
+    const Setup multirate   = [](Scheme& s) {
+        s.setSamplePeriod(4, 2);
+        s.setSamplePeriod(5, 3, 1);
+    };
+    for (const auto method : {nrcki::Discretization::Euler, nrcki::Discretization::ZeroOrderHold,
+                              nrcki::Discretization::Tustin}) {
+        engines(method, single_rate);
+        engines(method, multirate);
+    }
+    fast_forward_settled();
+    image();
+    return report("engines");
+}
\ No newline at end of file